@@ -1,7 +1,12 @@
 #include <chrono>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <queue>
+#include <map>
+#include <deque>
 #include <sstream>
 #include <iomanip>
 #include <unordered_map>
@@ -90,6 +95,7 @@ class Package
     std::string id;
     int weight = 0;
     int distance = 0;
+    std::string group_id;
     double discount = 0.0f;
     double cost = 0.0f;
     float delivery_time = 0.0f;
@@ -118,8 +124,10 @@ public:
     int getWeight() { return weight; }
     int getDistance() { return distance; }
     float getDeliveryTime() { return delivery_time; }
+    std::string getGroupId() { return group_id; }
 
     void setDeliveryTime(float dt) { delivery_time = dt; }
+    void setGroupId(std::string group) { group_id = std::move(group); }
 
     friend std::ostream &operator<<(std::ostream &os, const Package &pkg)
     {
@@ -129,96 +137,248 @@ public:
     }
 };
 
-class Delivery
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define KP_KERNEL_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(KP_KERNEL_X86) && (defined(__GNUC__) || defined(__clang__))
+#define KP_TARGET_AVX2 __attribute__((target("avx2")))
+#define KP_TARGET_SSE42 __attribute__((target("sse4.2")))
+#else
+#define KP_TARGET_AVX2
+#define KP_TARGET_SSE42
+#endif
+
+// kp scores are packed as (count << 32) | weight, so a plain integer comparison of two scores
+// ranks them the same way as comparing count first and weight as tie-breaker.
+inline uint64_t PackScore(int count, int weight)
 {
-    static std::unordered_map<std::string, Offer> _offers;
+    return (static_cast<uint64_t>(count) << 32) | static_cast<uint32_t>(weight);
+}
 
-    static std::ofstream _logFile;
+inline int ScoreCount(uint64_t score) { return static_cast<int>(score >> 32); }
+inline int ScoreWeight(uint64_t score) { return static_cast<int>(score & 0xFFFFFFFFu); }
 
-    static std::string buildDateTimeString()
+struct KpKernel
+{
+    using relax_fn = void (*)(uint64_t *, uint64_t *, int, int, int);
+
+    // Relaxes scores[weight..capacity] with a single item of the given weight, i.e.
+    // scores[j] = max(scores[j], scores[j - weight] + PackScore(count, weight)), walking j downwards.
+    // An item is one package unless count says it is a whole group of them.
+    // Bit j of decisions is set for every cell the item strictly improves.
+    static void RelaxScores(uint64_t *scores, uint64_t *decisions, int capacity, int weight, int count = 1)
     {
-        auto sys_clock = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        active().relax(scores, decisions, capacity, weight, count);
+    }
 
-        std::tm time_info = *std::localtime(&sys_clock);
-        std::ostringstream oss;
-        oss << std::put_time(&time_info, "%d-%m-%Y-%H-%M-%S");
+    // Name of the kernel picked by CPUID on first use ("avx2", "sse4.2" or "scalar").
+    static const char *Name() { return active().name; }
 
-        return oss.str();
-    }
+private:
+    struct choice
+    {
+        relax_fn relax;
+        const char *name;
+    };
 
-    struct compositeValue
+    static void relaxCell(uint64_t *scores, uint64_t *decisions, int j, int weight, uint64_t item)
     {
-        int weight;
-        int count;
-        std::vector<size_t> bag;
+        uint64_t candidate = scores[j - weight] + item;
+        if (candidate > scores[j])
+        {
+            scores[j] = candidate;
+            decisions[j >> 6] |= (uint64_t{1} << (j & 63));
+        }
+    }
 
-        compositeValue(int wt, int ct, size_t itemIdx) : weight{wt}, count{ct}
+    static void relaxScalar(uint64_t *scores, uint64_t *decisions, int capacity, int weight, int count)
+    {
+        const uint64_t item = PackScore(count, weight);
+        for (int j = capacity; j >= weight; j--)
         {
-            bag = std::move(std::vector<size_t>(1, itemIdx));
+            relaxCell(scores, decisions, j, weight, item);
         }
-        compositeValue() : weight{0}, count{0}, bag{std::move(std::vector<size_t>())} {}
+    }
 
-        compositeValue(const compositeValue &other)
+#ifdef KP_KERNEL_X86
+    // Both vector kernels update the block [j - lanes + 1, j] from [j - weight - lanes + 1, j - weight].
+    // With weight >= lanes the source block lies entirely below the destination, so it still holds the
+    // previous package's scores, exactly as in the scalar downward sweep. Blocks are lane-aligned so the
+    // compare mask always lands inside a single decision word.
+    KP_TARGET_AVX2 static void relaxAvx2(uint64_t *scores, uint64_t *decisions, int capacity, int weight, int count)
+    {
+        const uint64_t item = PackScore(count, weight);
+        int j = capacity;
+
+        if (weight >= 4)
         {
-            weight = other.weight;
-            count = other.count;
-            bag = std::vector<size_t>();
-            for (auto &&i : other.bag)
+            for (; j >= weight && ((j + 1) & 3) != 0; j--)
             {
-                bag.push_back(i);
+                relaxCell(scores, decisions, j, weight, item);
+            }
+
+            const __m256i increment = _mm256_set1_epi64x(static_cast<long long>(item));
+            for (; j - 3 >= weight; j -= 4)
+            {
+                int base = j - 3;
+                __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(scores + base));
+                __m256i candidate = _mm256_add_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(scores + base - weight)), increment);
+                __m256i improved = _mm256_cmpgt_epi64(candidate, current);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(scores + base), _mm256_blendv_epi8(current, candidate, improved));
+
+                uint64_t mask = static_cast<uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(improved)));
+                decisions[base >> 6] |= mask << (base & 63);
             }
         }
 
-        compositeValue(compositeValue &&other)
+        for (; j >= weight; j--)
         {
-            weight = other.weight;
-            count = other.count;
-            bag = std::move(other.bag);
+            relaxCell(scores, decisions, j, weight, item);
         }
+    }
 
-        int GetWeight() { return weight; }
+    KP_TARGET_SSE42 static void relaxSse42(uint64_t *scores, uint64_t *decisions, int capacity, int weight, int count)
+    {
+        const uint64_t item = PackScore(count, weight);
+        int j = capacity;
 
-        void reset()
+        if (weight >= 2)
         {
-            weight = 0;
-            count = 0;
-            bag.clear();
+            for (; j >= weight && ((j + 1) & 1) != 0; j--)
+            {
+                relaxCell(scores, decisions, j, weight, item);
+            }
+
+            const __m128i increment = _mm_set1_epi64x(static_cast<long long>(item));
+            for (; j - 1 >= weight; j -= 2)
+            {
+                int base = j - 1;
+                __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i *>(scores + base));
+                __m128i candidate = _mm_add_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(scores + base - weight)), increment);
+                __m128i improved = _mm_cmpgt_epi64(candidate, current);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(scores + base), _mm_blendv_epi8(current, candidate, improved));
+
+                uint64_t mask = static_cast<uint64_t>(_mm_movemask_pd(_mm_castsi128_pd(improved)));
+                decisions[base >> 6] |= mask << (base & 63);
+            }
         }
 
-        bool operator>(const compositeValue &other)
+        for (; j >= weight; j--)
         {
-            if (count > other.count)
-                return true;
-            else if (count == other.count && weight > other.weight)
-                return true;
-            else
-                return false;
+            relaxCell(scores, decisions, j, weight, item);
         }
+    }
 
-        void operator=(const compositeValue &other) = delete;
-
-        void operator=(compositeValue &&other)
+    static bool cpuHasAvx2()
+    {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0, avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
         {
-            weight = other.weight;
-            count = other.count;
-            bag = std::move(other.bag);
+            return false;
         }
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+
+    static bool cpuHasSse42()
+    {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 1);
+        return (info[2] & (1 << 20)) != 0;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse4.2");
+#endif
+    }
+#endif
 
-        compositeValue operator+(const compositeValue &other)
+    static const choice &active()
+    {
+        static const choice selected = []
         {
-            compositeValue nv;
-            nv.weight = weight + other.weight;
-            nv.count = count + other.count;
-            for (auto &&i : other.bag)
+#ifdef KP_KERNEL_X86
+            if (cpuHasAvx2())
             {
-                nv.bag.push_back(i);
+                return choice{relaxAvx2, "avx2"};
             }
-            for (auto &&i : bag)
+            if (cpuHasSse42())
+            {
+                return choice{relaxSse42, "sse4.2"};
+            }
+#endif
+            return choice{relaxScalar, "scalar"};
+        }();
+        return selected;
+    }
+};
+
+class Delivery
+{
+    static std::unordered_map<std::string, Offer> _offers;
+
+    static std::ofstream _logFile;
+
+    static std::string buildDateTimeString()
+    {
+        auto sys_clock = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+
+        std::tm time_info = *std::localtime(&sys_clock);
+        std::ostringstream oss;
+        oss << std::put_time(&time_info, "%d-%m-%Y-%H-%M-%S");
+
+        return oss.str();
+    }
+
+    struct compositeValue
+    {
+        int weight;
+        int count;
+
+        compositeValue(int wt, int ct) : weight{wt}, count{ct} {}
+        compositeValue() : weight{0}, count{0} {}
+
+        int GetWeight() const { return weight; }
+    };
+
+    // One row of bits per package, bit j of row i is set when package i improved capacity j in kp.
+    // Walking these rows back from max_carriable_weight rebuilds the selected bag.
+    struct decisionBitmap
+    {
+        size_t words_per_item = 0;
+        std::vector<uint64_t> bits;
+
+        void resize(size_t no_of_items, int max_carriable_weight)
+        {
+            words_per_item = (static_cast<size_t>(max_carriable_weight) >> 6) + 1;
+            if (bits.size() < no_of_items * words_per_item)
             {
-                nv.bag.push_back(i);
+                bits.resize(no_of_items * words_per_item);
             }
+        }
 
-            return nv;
+        void clear(size_t item)
+        {
+            std::fill(bits.begin() + item * words_per_item, bits.begin() + (item + 1) * words_per_item, 0);
+        }
+
+        uint64_t *row(size_t item) { return bits.data() + item * words_per_item; }
+
+        bool test(size_t item, size_t capacity) const
+        {
+            return (bits[item * words_per_item + (capacity >> 6)] >> (capacity & 63)) & 1;
         }
     };
 
@@ -239,7 +399,7 @@ class Delivery
 
         for (size_t i = 0; i < packages.size(); i++)
         {
-            compositeObjects.push_back(compositeValue(packages[i].getWeight(), 1, i));
+            compositeObjects.push_back(compositeValue(packages[i].getWeight(), 1));
         }
         return compositeObjects;
     }
@@ -250,7 +410,7 @@ class Delivery
 
         for (size_t i = 0; i < packages.size(); i++)
         {
-            if (packages[i].getWeight() <= max_carriable_weight)
+            if (packages[i].getWeight() >= 0 && packages[i].getWeight() <= max_carriable_weight)
             {
                 availability[i] = true;
                 no_of_packages++;
@@ -259,28 +419,179 @@ class Delivery
         return availability;
     }
 
-    static void kp(std::vector<compositeValue> &compositeObjects,
-                   int max_carriable_weight,
-                   std::vector<bool> &availability,
-                   std::vector<compositeValue> &availableComputations)
+    // Packages sharing a group id (a multi-box order) ship on one vehicle or not at all. Each group leaves the
+    // weight queues and becomes one more composite object, packages.size() + its position in the returned list,
+    // weighing the whole group and counting each of its packages. kp then relaxes one item per group, placed at
+    // its first package. A group no vehicle can carry is never shipped.
+    static auto buildGroups(std::vector<Package> &packages, std::vector<bool> &availability, std::vector<compositeValue> &compositeObjects,
+                            int max_carriable_weight, int &no_of_packages, std::vector<size_t> &waiting_groups) -> std::vector<std::vector<size_t>>
     {
-        for (size_t i = 1; i <= compositeObjects.size(); i++)
+        std::vector<std::vector<size_t>> groups;
+        std::unordered_map<std::string, size_t> ids;
+
+        for (size_t i = 0; i < packages.size(); i++)
         {
-            if (availability[i - 1])
+            const std::string group = packages[i].getGroupId();
+            if (!group.empty())
             {
-                for (size_t j = max_carriable_weight; j >= compositeObjects[i - 1].GetWeight(); j--)
+                auto found = ids.emplace(group, groups.size());
+                if (found.second)
                 {
-                    compositeValue np;
-                    np = std::move(availableComputations[j - compositeObjects[i - 1].GetWeight()] + compositeObjects[i - 1]);
-                    if (np > availableComputations[j])
-                    {
-                        availableComputations[j] = std::move(np);
-                    }
+                    groups.emplace_back();
                 }
+                groups[found.first->second].push_back(i);
+            }
+        }
+
+        for (size_t g = 0; g < groups.size(); g++)
+        {
+            long long weight = 0;
+            bool available = true;
+            for (auto &&idx : groups[g])
+            {
+                weight += packages[idx].getWeight();
+                available = available && availability[idx];
+                if (availability[idx])
+                {
+                    availability[idx] = false;
+                    no_of_packages--;
+                }
+            }
+
+            if (available && weight <= max_carriable_weight)
+            {
+                compositeObjects.push_back(compositeValue(static_cast<int>(weight), static_cast<int>(groups[g].size())));
+                waiting_groups.push_back(packages.size() + g);
+                no_of_packages += groups[g].size();
+            }
+            else
+            {
+                compositeObjects.push_back(compositeValue());
+            }
+        }
+        return groups;
+    }
+
+    // kp always ships the lowest indices of every weight it uses, swapping one for a waiting package of the same
+    // weight and a lower index keeps the score and gives a bag kp prefers. So per weight, in index order, only the
+    // first packages need a kp row : no more than fit in one vehicle and no more than the largest shipment count.
+    static auto buildWeightQueues(std::vector<Package> &packages, std::vector<bool> &availability) -> std::map<int, std::deque<size_t>>
+    {
+        std::map<int, std::deque<size_t>> queues;
+
+        for (size_t i = 0; i < packages.size(); i++)
+        {
+            if (availability[i])
+            {
+                queues[packages[i].getWeight()].push_back(i);
+            }
+        }
+        return queues;
+    }
+
+    static auto nextCandidates(std::map<int, std::deque<size_t>> &queues, int max_carriable_weight) -> std::vector<size_t>
+    {
+        long long load = 0;
+        size_t max_count = 0;
+
+        for (auto &&queue : queues)
+        {
+            size_t fit = queue.first == 0 ? queue.second.size() : std::min<long long>(queue.second.size(), (max_carriable_weight - load) / queue.first);
+            max_count += fit;
+            load += static_cast<long long>(fit) * queue.first;
+            if (fit < queue.second.size())
+            {
+                break;
+            }
+        }
+
+        std::vector<size_t> candidates;
+        for (auto &&queue : queues)
+        {
+            size_t take = std::min(queue.second.size(), max_count);
+            if (queue.first > 0)
+            {
+                take = std::min<size_t>(take, max_carriable_weight / queue.first);
+            }
+            candidates.insert(candidates.end(), queue.second.begin(), queue.second.begin() + take);
+        }
+
+        std::sort(candidates.begin(), candidates.end());
+        return candidates;
+    }
+
+    static void removeShipped(std::map<int, std::deque<size_t>> &queues, std::vector<Package> &packages, const std::vector<size_t> &shipped)
+    {
+        for (auto &&idx : shipped)
+        {
+            auto queue = queues.find(packages[idx].getWeight());
+            auto item = std::find(queue->second.begin(), queue->second.end(), idx);
+            queue->second.erase(item);
+            if (queue->second.empty())
+            {
+                queues.erase(queue);
             }
         }
     }
 
+    // Weights and capacity are divided by the gcd of the available weights, and the capacity is clamped to their
+    // total since no shipment can use more. kp then finds the same bag on a much narrower row.
+    static int compressCapacity(std::vector<compositeValue> &compositeObjects, const std::vector<size_t> &candidates, int max_carriable_weight, int &divisor)
+    {
+        long long total = 0;
+        divisor = 0;
+
+        for (auto &&i : candidates)
+        {
+            int a = divisor, b = compositeObjects[i].GetWeight();
+            while (b != 0)
+            {
+                int r = a % b;
+                a = b;
+                b = r;
+            }
+            divisor = a;
+            total += compositeObjects[i].GetWeight();
+        }
+
+        if (divisor <= 1)
+        {
+            divisor = 1;
+        }
+        return static_cast<int>(std::min<long long>(max_carriable_weight / divisor, total / divisor));
+    }
+
+    static auto kp(std::vector<compositeValue> &compositeObjects,
+                   int max_carriable_weight,
+                   int divisor,
+                   const std::vector<size_t> &candidates,
+                   std::vector<uint64_t> &availableComputations,
+                   decisionBitmap &decisions) -> std::vector<size_t>
+    {
+        availableComputations.assign(max_carriable_weight + 1, 0);
+        decisions.resize(candidates.size(), max_carriable_weight);
+
+        for (size_t k = 0; k < candidates.size(); k++)
+        {
+            decisions.clear(k);
+            const compositeValue &item = compositeObjects[candidates[k]];
+            KpKernel::RelaxScores(availableComputations.data(), decisions.row(k), max_carriable_weight, item.GetWeight() / divisor, item.count);
+        }
+
+        std::vector<size_t> bag;
+        int capacity = max_carriable_weight;
+
+        for (size_t k = candidates.size(); k > 0; k--)
+        {
+            if (decisions.test(k - 1, capacity))
+            {
+                bag.push_back(candidates[k - 1]);
+                capacity -= compositeObjects[candidates[k - 1]].GetWeight() / divisor;
+            }
+        }
+        return bag;
+    }
+
     Delivery() = delete;
 
 public:
@@ -321,11 +632,34 @@ public:
 
         float cost = 0.0f, discount = 0.0f;
 
+        // A package line may end with the group of its order, a missing line reads as an empty one. Lines written for
+        // the modular solution may put a volume before the group, it is numeric and skipped here.
+        std::string line, group_id;
+
         for (size_t i = 0; i < no_of_packages; i++)
         {
-            is >> pkg_id >> pkg_weight_in_kg >> pkg_distance_in_km >> offer_id;
+            line.clear();
+            std::getline(is >> std::ws, line);
+            std::istringstream fields(line);
+            // A short line leaves its missing fields empty, not at the values of the line before it.
+            pkg_id.clear();
+            offer_id.clear();
+            pkg_weight_in_kg = pkg_distance_in_km = 0;
+            fields >> pkg_id >> pkg_weight_in_kg >> pkg_distance_in_km >> offer_id;
             Package pkg(pkg_id, pkg_weight_in_kg, pkg_distance_in_km);
 
+            if (fields >> group_id)
+            {
+                int volume = 0;
+                std::istringstream number(group_id);
+                if (number >> volume && number.eof())
+                {
+                    group_id.clear();
+                    fields >> group_id;
+                }
+                pkg.setGroupId(group_id);
+            }
+
             auto offer = _offers.find(offer_id);
 
             if (offer != _offers.end())
@@ -355,18 +689,58 @@ public:
     static void Delivery_Time(std::vector<Package> &packages, int no_of_vehicles, int max_speed, int max_carriable_weight)
     {
         int no_of_packages = 0;
-        std::vector<compositeValue> availableComputations(max_carriable_weight + 1, compositeValue());
+        std::vector<uint64_t> availableComputations;
         std::vector<bool> availability = std::move(buildAvailability(packages, max_carriable_weight, no_of_packages));
 
         auto agent_queue = std::move(get_agent_queue(no_of_vehicles));
         auto compositeObjects = std::move(get_pre_computed_composite_objects(packages));
 
+        std::vector<size_t> waiting_groups;
+        auto groups = std::move(buildGroups(packages, availability, compositeObjects, max_carriable_weight, no_of_packages, waiting_groups));
+        auto waiting = std::move(buildWeightQueues(packages, availability));
+
+        // Where kp meets an item, a group at its first package.
+        const auto position = [&packages, &groups](size_t item)
+        {
+            return item < packages.size() ? item : groups[item - packages.size()].front();
+        };
+
+        decisionBitmap decisions;
+
         while (no_of_packages)
         {
-            kp(compositeObjects, max_carriable_weight, availability, availableComputations);
-            auto &best = availableComputations[max_carriable_weight];
+            auto candidates = std::move(nextCandidates(waiting, max_carriable_weight));
+            if (!waiting_groups.empty())
+            {
+                candidates.insert(candidates.end(), waiting_groups.begin(), waiting_groups.end());
+                std::sort(candidates.begin(), candidates.end(),
+                          [&position](size_t lhs, size_t rhs)
+                          {
+                              return position(lhs) < position(rhs);
+                          });
+            }
+
+            int divisor = 1;
+            int capacity = compressCapacity(compositeObjects, candidates, max_carriable_weight, divisor);
+            auto best = kp(compositeObjects, capacity, divisor, candidates, availableComputations, decisions);
+
+            // The shipped groups hand over their packages.
+            auto group_end = std::partition(best.begin(), best.end(),
+                                            [&packages](size_t item)
+                                            {
+                                                return item < packages.size();
+                                            });
+            std::vector<size_t> shipped_groups(group_end, best.end());
+            best.erase(group_end, best.end());
+            removeShipped(waiting, packages, best);
+
+            for (auto &&group : shipped_groups)
+            {
+                waiting_groups.erase(std::find(waiting_groups.begin(), waiting_groups.end(), group));
+                best.insert(best.end(), groups[group - packages.size()].begin(), groups[group - packages.size()].end());
+            }
 
-            sort(best.bag.begin(), best.bag.end(),
+            sort(best.begin(), best.end(),
                  [&packages](const int pkg1, const int pkg2)
                  {
                      return packages[pkg1].getDistance() < packages[pkg2].getDistance();
@@ -374,9 +748,8 @@ public:
 
             int available_agent = agent_queue.top(), max_agent_busy_time = 0;
 
-            for (auto &&idx : best.bag)
+            for (auto &&idx : best)
             {
-                availability[idx] = false;
                 max_agent_busy_time = available_agent + ((static_cast<long long>(packages[idx].getDistance()) * 100) / max_speed);
                 packages[idx].setDeliveryTime(static_cast<float>(max_agent_busy_time) / 100);
             }
@@ -384,12 +757,7 @@ public:
             agent_queue.pop();
             agent_queue.push(max_agent_busy_time * 2);
 
-            no_of_packages -= best.bag.size();
-
-            for (auto &&ac : availableComputations)
-            {
-                ac.reset();
-            }
+            no_of_packages -= best.size();
         }
     }
 };
@@ -0,0 +1,601 @@
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <chrono>
+#include <string>
+#include <sstream>
+#include <map>
+#include <vector>
+#include <thread>
+#include <cstdlib>
+#include <new>
+#include <limits>
+#include <functional>
+#include "delivery_logic.h"
+#include "tiled_kp.h"
+#include "shipment_cache.h"
+#include "two_constraint_selector.h"
+
+// Every global heap allocation made by the benchmark, to show what the planning arena keeps off the heap.
+static size_t global_allocations = 0;
+
+void *operator new(size_t size)
+{
+    global_allocations++;
+    if (void *p = std::malloc(size == 0 ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    std::free(p);
+}
+
+std::vector<Package> random_packages(int no_of_packages, int min_weight, int max_weight, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> weight(min_weight, max_weight), distance(1, 200);
+    std::vector<Package> packages;
+
+    for (int i = 0; i < no_of_packages; i++)
+    {
+        packages.emplace_back("pkg_id" + std::to_string(i), weight(rng), distance(rng));
+    }
+    return packages;
+}
+
+double time_selection(std::vector<Package> &packages, int max_carriable_weight, const SelectionOptions &options, std::vector<size_t> &bag)
+{
+    auto start = std::chrono::steady_clock::now();
+    bag = Delivery::SelectShipment(packages, max_carriable_weight, options);
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+double time_selection(std::vector<Package> &packages, int max_carriable_weight, SelectionEngine engine, std::vector<size_t> &bag,
+                      unsigned threads = 1)
+{
+    SelectionOptions options;
+    options.engine = engine;
+    options.threads = threads;
+
+    return time_selection(packages, max_carriable_weight, options, bag);
+}
+
+std::vector<Package> standard_boxes(int no_of_packages, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::vector<int> box_weights = {5, 10, 20, 25, 50};
+    std::uniform_int_distribution<int> box(0, static_cast<int>(box_weights.size()) - 1), distance(1, 200);
+    std::vector<Package> packages;
+
+    for (int i = 0; i < no_of_packages; i++)
+    {
+        packages.emplace_back("pkg_id" + std::to_string(i), box_weights[box(rng)], distance(rng));
+    }
+    return packages;
+}
+
+long long shipment_weight(std::vector<Package> &packages, const std::vector<size_t> &bag)
+{
+    long long weight = 0;
+    for (auto &&idx : bag)
+    {
+        weight += packages[idx].getWeight();
+    }
+    return weight;
+}
+
+void compare_engines(const std::string &name, std::vector<Package> packages, int max_carriable_weight)
+{
+    const std::vector<std::pair<std::string, SelectionEngine>> engines =
+        {
+            std::make_pair("kp (dense dp)", SelectionEngine::DenseDP),
+            std::make_pair("bitset", SelectionEngine::Bitset),
+            std::make_pair("count-first", SelectionEngine::CountFirst),
+            std::make_pair("weight classes", SelectionEngine::WeightClasses),
+            std::make_pair("sparse", SelectionEngine::Sparse),
+            std::make_pair("meet in middle", SelectionEngine::MeetInTheMiddle),
+            std::make_pair("branch & bound", SelectionEngine::BranchAndBound)};
+
+    std::vector<size_t> dense_bag, bag;
+    double dense = time_selection(packages, max_carriable_weight, SelectionEngine::DenseDP, dense_bag);
+
+    std::cout << "Benchmark : " << name << " (n = " << packages.size() << ", C = " << max_carriable_weight << ", bag = " << dense_bag.size() << ")" << '\n';
+    std::cout << std::fixed << std::setprecision(2);
+
+    for (auto &&engine : engines)
+    {
+        double elapsed = engine.second == SelectionEngine::DenseDP ? dense : time_selection(packages, max_carriable_weight, engine.second, bag);
+        bool same_score = engine.second == SelectionEngine::DenseDP ||
+                          (bag.size() == dense_bag.size() && shipment_weight(packages, bag) == shipment_weight(packages, dense_bag));
+        std::cout << "\t " << std::left << std::setw(15) << engine.first << ": " << elapsed << " ms" << (same_score ? "" : " (SCORE MISMATCH)") << '\n';
+    }
+}
+
+void scale_threads(const std::string &name, std::vector<Package> packages, int max_carriable_weight)
+{
+    std::vector<size_t> serial_bag, bag;
+    double serial = time_selection(packages, max_carriable_weight, SelectionEngine::DenseDP, serial_bag);
+
+    std::cout << "Benchmark : " << name << " (n = " << packages.size() << ", C = " << max_carriable_weight
+              << ", hardware threads = " << std::thread::hardware_concurrency() << ")" << '\n';
+    std::cout << std::fixed << std::setprecision(2);
+
+    for (unsigned threads : {1u, 2u, 4u, 8u, 16u, 32u})
+    {
+        double elapsed = threads == 1 ? serial : time_selection(packages, max_carriable_weight, SelectionEngine::DenseDP, bag, threads);
+        bool same_bag = threads == 1 || bag == serial_bag;
+        std::cout << "\t " << std::left << std::setw(15) << (std::to_string(threads) + " threads") << ": " << elapsed << " ms, x"
+                  << serial / elapsed << (same_bag ? "" : " (BAG MISMATCH)") << '\n';
+    }
+}
+
+void compare_sweeps(const std::string &name, std::vector<Package> packages, int max_carriable_weight)
+{
+    SelectionOptions options;
+    options.engine = SelectionEngine::DenseDP;
+    options.tiled_sweep = false;
+
+    std::vector<size_t> plain_bag, tiled_bag;
+    double plain = time_selection(packages, max_carriable_weight, options, plain_bag);
+    options.tiled_sweep = true;
+    double tiled = time_selection(packages, max_carriable_weight, options, tiled_bag);
+
+    std::cout << "Benchmark : " << name << " (n = " << packages.size() << ", C = " << max_carriable_weight
+              << ", block = " << TiledBlockCells() << " cells)" << '\n';
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "\t " << std::left << std::setw(15) << "plain sweep" << ": " << plain << " ms" << '\n';
+    std::cout << "\t " << std::left << std::setw(15) << "tiled sweep" << ": " << tiled << " ms, x" << plain / tiled
+              << (tiled_bag == plain_bag ? "" : " (BAG MISMATCH)") << '\n';
+}
+
+void count_allocations(const std::string &name, const std::vector<Package> &packages, int max_carriable_weight)
+{
+    std::cout << "Benchmark : " << name << " (n = " << packages.size() << ", C = " << max_carriable_weight << ")" << '\n';
+
+    for (bool planning_arena : {false, true})
+    {
+        SelectionOptions options;
+        options.planning_arena = planning_arena;
+        std::vector<Package> plan(packages);
+
+        size_t before = global_allocations;
+        auto start = std::chrono::steady_clock::now();
+        Delivery::Delivery_Time(plan, 3, 70, max_carriable_weight, options);
+        auto end = std::chrono::steady_clock::now();
+
+        std::cout << "\t " << std::left << std::setw(15) << (planning_arena ? "planning arena" : "global heap") << ": "
+                  << global_allocations - before << " allocations, "
+                  << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << '\n';
+    }
+}
+
+void compare_fixed_capacities(const std::string &name, const std::vector<Package> &packages)
+{
+    std::cout << "Benchmark : " << name << " (n = " << packages.size() << ", kp for every shipment)" << '\n';
+    std::cout << std::fixed << std::setprecision(2);
+
+    for (int max_carriable_weight : {200, 500, 1000})
+    {
+        double elapsed[2];
+        for (bool fixed_capacities : {false, true})
+        {
+            SelectionOptions options;
+            options.engine = SelectionEngine::DenseDP;
+            options.fixed_capacities = fixed_capacities;
+            std::vector<Package> plan(packages);
+
+            auto start = std::chrono::steady_clock::now();
+            Delivery::Delivery_Time(plan, 3, 70, max_carriable_weight, options);
+            elapsed[fixed_capacities] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        std::cout << "\t " << std::left << std::setw(15) << ("C = " + std::to_string(max_carriable_weight)) << ": "
+                  << elapsed[0] << " ms dynamic, " << elapsed[1] << " ms fixed" << '\n';
+    }
+}
+
+void count_scanned_items(const std::string &name, const std::vector<Package> &packages, int max_carriable_weight)
+{
+    std::vector<Package> plan(packages);
+    Delivery::Delivery_Time(plan, 3, 70, max_carriable_weight);
+
+    const auto &scanned = Delivery::ItemsScannedPerRound();
+    size_t total = 0, most = 0;
+    for (auto &&items : scanned)
+    {
+        total += items;
+        most = std::max(most, items);
+    }
+
+    std::cout << "Benchmark : " << name << " (n = " << packages.size() << ", C = " << max_carriable_weight << ")" << '\n';
+    std::cout << "\t " << scanned.size() << " rounds, " << total << " items scanned, "
+              << static_cast<double>(total) / scanned.size() << " per round, " << most << " at most" << '\n';
+}
+
+void compare_trivial_rounds(const std::string &name, const std::vector<Package> &packages, int max_carriable_weight)
+{
+    std::cout << "Benchmark : " << name << " (n = " << packages.size() << ", C = " << max_carriable_weight << ")" << '\n';
+
+    for (bool trivial_rounds : {false, true})
+    {
+        SelectionOptions options;
+        options.trivial_rounds = trivial_rounds;
+        std::vector<Package> plan(packages);
+
+        auto start = std::chrono::steady_clock::now();
+        Delivery::Delivery_Time(plan, 3, 70, max_carriable_weight, options);
+        auto end = std::chrono::steady_clock::now();
+
+        std::cout << "\t " << std::left << std::setw(15) << (trivial_rounds ? "fast paths" : "engine only") << ": "
+                  << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << '\n';
+    }
+}
+
+void replay_with_cache(const std::string &name, const std::vector<Package> &packages, int max_carriable_weight)
+{
+    std::cout << "Benchmark : " << name << " (n = " << packages.size() << ", C = " << max_carriable_weight << ", 3 plans)" << '\n';
+
+    for (size_t shipment_cache : {size_t{0}, size_t{4096}})
+    {
+        SelectionOptions options;
+        options.engine = SelectionEngine::DenseDP;
+        options.shipment_cache = shipment_cache;
+        auto &cache = SharedShipmentCache(shipment_cache);
+        cache.Clear();
+
+        std::cout << "\t " << std::left << std::setw(15) << (shipment_cache ? "cached" : "uncached") << ":";
+        for (int plan_no = 0; plan_no < 3; plan_no++)
+        {
+            std::vector<Package> plan(packages);
+            auto start = std::chrono::steady_clock::now();
+            Delivery::Delivery_Time(plan, 3, 70, max_carriable_weight, options);
+            std::cout << " " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() << " ms";
+        }
+        std::cout << " (" << cache.Hits() << " hits, " << cache.Misses() << " misses, " << cache.Evictions() << " evictions)" << '\n';
+    }
+}
+
+// Plans with kp in every round against the engine the cost model picks, and counts the rounds each engine took.
+void compare_auto_selection(const std::string &name, const std::vector<Package> &packages, int max_carriable_weight)
+{
+    std::cout << "Benchmark : " << name << " (n = " << packages.size() << ", C = " << max_carriable_weight << ")" << '\n';
+
+    for (SelectionEngine engine : {SelectionEngine::DenseDP, SelectionEngine::Auto})
+    {
+        std::stringstream metrics;
+        SelectionOptions options;
+        options.engine = engine;
+        options.metrics = &metrics;
+
+        std::vector<Package> plan(packages);
+        auto start = std::chrono::steady_clock::now();
+        Delivery::Delivery_Time(plan, 3, 70, max_carriable_weight, options);
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::map<std::string, size_t> rounds;
+        std::string line;
+        while (std::getline(metrics, line, '\n'))
+        {
+            const size_t from = line.find(" : ") + 3;
+            rounds[line.substr(from, line.find(',') - from)]++;
+        }
+
+        std::cout << "\t " << std::left << std::setw(15) << (engine == SelectionEngine::Auto ? "cheapest" : "kp (dense dp)") << ": " << elapsed << " ms,";
+        for (auto &&engine_rounds : rounds)
+        {
+            std::cout << " " << engine_rounds.first << " x" << engine_rounds.second;
+        }
+        std::cout << '\n';
+    }
+}
+
+// SelectWithVehicleLimits against a plain table of (count, weight) scores over every (weight, volume) pair, which
+// only finds the score and no bag.
+void compare_volume_limits(const std::string &name, int no_of_packages, int max_carriable_weight, int max_volume, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> weight(1, max_carriable_weight / 5), volume(1, max_volume / 5);
+    SelectionItems items;
+    for (int i = 0; i < no_of_packages; i++)
+    {
+        items.push_back(SelectionItem{static_cast<size_t>(i), weight(rng), 0, volume(rng)});
+    }
+    VehicleLimits limits;
+    limits.max_volume = max_volume;
+
+    std::cout << "Benchmark : " << name << " (n = " << no_of_packages << ", C = " << max_carriable_weight << ", V = " << max_volume << ")" << '\n';
+
+    auto start = std::chrono::steady_clock::now();
+    const size_t columns = max_volume + 1;
+    std::vector<long long> table((max_carriable_weight + 1) * columns, 0);
+    for (auto &&item : items)
+    {
+        for (int w = max_carriable_weight; w >= item.weight; w--)
+        {
+            for (int v = max_volume; v >= item.volume; v--)
+            {
+                // count * (C + 1) + weight, so that more packages always win.
+                long long score = table[(w - item.weight) * columns + v - item.volume] + max_carriable_weight + 1 + item.weight;
+                table[w * columns + v] = std::max(table[w * columns + v], score);
+            }
+        }
+    }
+    const long long table_score = table.back();
+    double table_time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    ArenaVector<size_t> bag;
+    SelectWithVehicleLimits(items, max_carriable_weight, limits, bag);
+    double limited_time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    long long bag_score = 0;
+    for (auto &&idx : bag)
+    {
+        bag_score += max_carriable_weight + 1 + items[idx].weight;
+    }
+    std::cout << "\t " << std::left << std::setw(15) << "C x V table" << ": " << table_time << " ms" << '\n';
+    std::cout << "\t " << std::left << std::setw(15) << "two-constraint" << ": " << limited_time << " ms, bag = " << bag.size()
+              << (bag_score == table_score ? "" : " (SCORE MISMATCH)") << '\n';
+}
+
+// A mixed fleet all free at the start of the day : the kp sweeps of one round for every vehicle class against the
+// single sweep up to the largest class, then a whole plan.
+void plan_mixed_fleet(const std::string &name, const std::vector<Package> &packages, const std::vector<Vehicle> &fleet)
+{
+    std::cout << "Benchmark : " << name << " (n = " << packages.size() << ", " << fleet.size() << " vehicles)" << '\n';
+
+    std::vector<int> capacities;
+    for (auto &&vehicle : fleet)
+    {
+        capacities.push_back(vehicle.max_carriable_weight);
+    }
+    std::sort(capacities.begin(), capacities.end());
+    capacities.erase(std::unique(capacities.begin(), capacities.end()), capacities.end());
+
+    SelectionOptions options;
+    options.engine = SelectionEngine::DenseDP;
+    std::vector<Package> round(packages);
+    std::vector<size_t> bag;
+    double per_class = 0;
+    for (auto &&capacity : capacities)
+    {
+        per_class += time_selection(round, capacity, options, bag);
+    }
+    double shared = time_selection(round, capacities.back(), options, bag);
+    std::cout << "\t " << std::left << std::setw(15) << "kp per class" << ": " << per_class << " ms" << '\n';
+    std::cout << "\t " << std::left << std::setw(15) << "one sweep" << ": " << shared << " ms" << '\n';
+
+    std::stringstream metrics;
+    options.engine = SelectionEngine::Auto;
+    options.metrics = &metrics;
+    std::vector<Package> plan(packages);
+    auto start = std::chrono::steady_clock::now();
+    Delivery::Delivery_Time(plan, fleet, options);
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    size_t shared_rounds = 0;
+    std::string line;
+    while (std::getline(metrics, line, '\n'))
+    {
+        shared_rounds += line.find(" : fleet,") != std::string::npos;
+    }
+    std::cout << "\t " << std::left << std::setw(15) << "plan" << ": " << elapsed << " ms, " << Delivery::ItemsScannedPerRound().size()
+              << " rounds, " << shared_rounds << " answered by one sweep for several classes" << '\n';
+}
+
+void pack_free_vehicles(const std::string &name, const std::vector<Package> &packages, int no_of_vehicles, int max_carriable_weight)
+{
+    std::cout << "Benchmark : " << name << " (n = " << packages.size() << ", " << no_of_vehicles << " vehicles, capacity "
+              << max_carriable_weight << ")" << '\n';
+
+    for (auto &&engine : {SelectionEngine::DenseDP, SelectionEngine::Auto})
+    {
+        for (bool pack : {false, true})
+        {
+            std::stringstream metrics;
+            SelectionOptions options;
+            options.engine = engine;
+            options.pack_free_vehicles = pack;
+            options.metrics = &metrics;
+
+            std::vector<Package> plan(packages);
+            auto start = std::chrono::steady_clock::now();
+            Delivery::Delivery_Time(plan, no_of_vehicles, 70, max_carriable_weight, options);
+            double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            // Every vehicle is free at the start of the shift, so the first rounds are the latency peak.
+            size_t repeated = 0, shipped_at_start = 0;
+            std::string line;
+            for (int round = 0; std::getline(metrics, line, '\n'); round++)
+            {
+                repeated += line.find(" : repeat,") != std::string::npos;
+                if (round < no_of_vehicles)
+                {
+                    const size_t to = line.find(" shipped"), from = line.rfind(", ", to) + 2;
+                    shipped_at_start += std::stoul(line.substr(from, to - from));
+                }
+            }
+            const std::string label = std::string(engine == SelectionEngine::Auto ? "auto" : "dense") + (pack ? ", packed" : "");
+            std::cout << "\t " << std::left << std::setw(15) << label << ": " << elapsed << " ms, "
+                      << Delivery::ItemsScannedPerRound().size() << " rounds, " << repeated << " repeated, "
+                      << shipped_at_start << " packages out at the start" << '\n';
+        }
+    }
+}
+
+void compare_grouped_orders(const std::string &name, std::vector<Package> packages, int max_carriable_weight, unsigned seed)
+{
+    // Orders of 1 to 4 boxes, the boxes of an order next to each other.
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> boxes(1, 4);
+    size_t orders = 0;
+    for (size_t i = 0; i < packages.size(); orders++)
+    {
+        const int order_size = boxes(rng);
+        for (int box = 0; box < order_size && i < packages.size(); box++, i++)
+        {
+            packages[i].setGroupId(order_size > 1 ? "order" + std::to_string(orders) : "");
+        }
+    }
+    std::cout << "Benchmark : " << name << " (n = " << packages.size() << ", " << orders << " orders, C = " << max_carriable_weight << ")" << '\n';
+
+    PlanningArena arena;
+    PlanningArena::Scope scope(&arena);
+    WaitingPackages waiting(packages, max_carriable_weight);
+    const PackageGroups groups(packages);
+    SelectionScratch scratch;
+    ArenaVector<size_t> grouped_bag;
+
+    auto start = std::chrono::steady_clock::now();
+    SelectGroups(waiting.All(), groups, max_carriable_weight, scratch, grouped_bag);
+    double grouped = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // The same round with every box relaxed on its own, as kp would without groups.
+    SelectionItems boxes_items = waiting.All();
+    ArenaVector<size_t> box_bag;
+    start = std::chrono::steady_clock::now();
+    const int capacity = CompressCapacity(boxes_items, max_carriable_weight);
+    scratch.scores.assign(capacity + 1, 0);
+    scratch.decisions.resize(boxes_items.size(), capacity);
+    for (size_t i = 0; i < boxes_items.size(); i++)
+    {
+        scratch.decisions.clear(i);
+        RelaxScores(scratch.scores.data(), scratch.decisions.row(i), capacity, boxes_items[i].weight);
+    }
+    double per_box = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "\t " << std::left << std::setw(15) << "kp per box" << ": " << per_box << " ms" << '\n';
+    std::cout << "\t " << std::left << std::setw(15) << "one per order" << ": " << grouped << " ms, " << grouped_bag.size() << " boxes shipped" << '\n';
+
+    start = std::chrono::steady_clock::now();
+    Delivery::Delivery_Time(packages, 10, 70, max_carriable_weight);
+    double plan = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "\t " << std::left << std::setw(15) << "plan" << ": " << plan << " ms, " << Delivery::ItemsScannedPerRound().size() << " rounds" << '\n';
+}
+
+void compare_objectives(const std::string &name, std::vector<Package> packages, int max_carriable_weight)
+{
+    std::cout << "Benchmark : " << name << " (n = " << packages.size() << ", C = " << max_carriable_weight << ")" << '\n';
+
+    std::vector<int> priorities, revenue;
+    for (size_t i = 0; i < packages.size(); i++)
+    {
+        packages[i].CalculateCost(100, Offer());
+        priorities.push_back(i % 10 == 0 ? 2 : 1);
+        revenue.push_back(static_cast<int>(packages[i].getCost() * 100));
+    }
+
+    PlanningArena arena;
+    PlanningArena::Scope scope(&arena);
+    WaitingPackages waiting(packages, max_carriable_weight);
+    const SelectionItems items = waiting.All();
+    SelectionScratch scratch;
+
+    // The dense engine as Delivery_Time runs it, on a single thread and without the fixed rows or tiling.
+    SelectionOptions options;
+    options.fixed_capacities = false;
+    options.tiled_sweep = false;
+    const ShipmentSelector *dense = Delivery::Selectors().Find(SelectionEngine::DenseDP);
+
+    const int repeats = 15;
+    const auto best_of = [repeats](const std::function<void()> &run)
+    {
+        double best = std::numeric_limits<double>::infinity();
+        for (int r = 0; r < repeats; r++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            run();
+            best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        return best;
+    };
+
+    ArenaVector<size_t> wired_bag, policy_bag, bag;
+    const double wired = best_of([&]
+                                 {
+                                     SelectionItems compressed(items);
+                                     const int capacity = CompressCapacity(compressed, max_carriable_weight);
+                                     dense->Select(compressed, capacity, options, std::numeric_limits<double>::infinity(), scratch, wired_bag);
+                                 });
+    const double policy = best_of([&]
+                                  {
+                                      SelectByObjective(items, max_carriable_weight, CountThenWeight(), scratch, policy_bag);
+                                  });
+    const double priority = best_of([&]
+                                    {
+                                        SelectByObjective(items, max_carriable_weight, PriorityThenWeight{priorities.data()}, scratch, bag);
+                                    });
+    const double by_revenue = best_of([&]
+                                      {
+                                          SelectByObjective(items, max_carriable_weight, RevenueThenWeight{revenue.data()}, scratch, bag);
+                                      });
+
+    std::cout << "\t " << std::left << std::setw(15) << "hard-wired kp" << ": " << wired << " ms" << '\n';
+    std::cout << "\t " << std::left << std::setw(15) << "count policy" << ": " << policy << " ms" << (policy_bag == wired_bag ? "" : " (BAG MISMATCH)") << '\n';
+    std::cout << "\t " << std::left << std::setw(15) << "priority policy" << ": " << priority << " ms" << '\n';
+    std::cout << "\t " << std::left << std::setw(15) << "revenue policy" << ": " << by_revenue << " ms" << '\n';
+}
+
+int main()
+{
+    const int no_of_packages = 10000, max_carriable_weight = 10000;
+
+    compare_engines("uniform weights", random_packages(no_of_packages, 1, max_carriable_weight, 1), max_carriable_weight);
+    compare_engines("heavy parcels", random_packages(no_of_packages, max_carriable_weight / 10, max_carriable_weight, 2), max_carriable_weight);
+    compare_engines("small parcels", random_packages(no_of_packages, 1, 200, 3), max_carriable_weight);
+    compare_engines("standard boxes", standard_boxes(no_of_packages, 4), max_carriable_weight);
+
+    const int grams_capacity = 1000000;
+    compare_engines("few parcels in grams", random_packages(30, 1, grams_capacity, 5), grams_capacity);
+    compare_engines("express lane in grams", random_packages(40, grams_capacity / 8, grams_capacity / 3, 6), grams_capacity);
+
+    count_allocations("full plan", random_packages(2000, 1, 200, 10), 200);
+    count_allocations("full plan of standard boxes", standard_boxes(2000, 11), 200);
+
+    count_scanned_items("items scanned", random_packages(20000, 1, 200, 13), 200);
+    count_scanned_items("items scanned for standard boxes", standard_boxes(20000, 14), 200);
+
+    compare_trivial_rounds("trivial rounds", random_packages(20000, 1, 200, 15), 200);
+    compare_trivial_rounds("trivial rounds of standard boxes", standard_boxes(20000, 16), 200);
+    compare_trivial_rounds("trivial rounds of light parcels", random_packages(20000, 1, 20, 17), 1000);
+
+    replay_with_cache("re-plans", random_packages(2000, 1, 200, 18), 200);
+    replay_with_cache("re-plans of standard boxes", standard_boxes(2000, 19), 1000);
+
+    compare_auto_selection("cheapest engine", random_packages(5000, 1, 1000, 20), 1000);
+    compare_auto_selection("cheapest engine in decagrams", random_packages(2000, 1, 2000, 21), 10000);
+    compare_auto_selection("cheapest engine for standard boxes", standard_boxes(5000, 22), 1000);
+
+    compare_volume_limits("volume limit", 500, 1000, 1000, 23);
+    compare_volume_limits("volume limit in litres", 200, 2000, 5000, 24);
+
+    std::vector<Vehicle> fleet(8, Vehicle{30, 50, VehicleLimits()});
+    fleet.insert(fleet.end(), 4, Vehicle{60, 1000, VehicleLimits()});
+    fleet.insert(fleet.end(), 2, Vehicle{50, 5000, VehicleLimits()});
+    plan_mixed_fleet("bikes, vans and trucks", random_packages(5000, 1, 200, 25), fleet);
+
+    pack_free_vehicles("shift start", random_packages(5000, 1, 1000, 26), 400, 1000);
+    pack_free_vehicles("shift start of standard boxes", standard_boxes(5000, 27), 400, 1000);
+
+    compare_grouped_orders("multi-box orders", random_packages(5000, 1, 200, 28), 5000, 29);
+    compare_grouped_orders("multi-box orders of standard boxes", standard_boxes(5000, 30), 5000, 31);
+
+    compare_objectives("objective policies", random_packages(2000, 1, 200, 32), 10000);
+    compare_objectives("objective policies in grams", random_packages(200, 1, 100000, 33), 200000);
+
+    compare_fixed_capacities("standard vehicle classes", random_packages(20000, 1, 200, 12));
+
+    compare_sweeps("tiled sweep in decagrams", random_packages(500, 1, 40000, 9), 10 * grams_capacity);
+
+    scale_threads("dense sweep in grams", random_packages(400, grams_capacity / 40, grams_capacity / 4, 7), grams_capacity);
+}
@@ -0,0 +1,100 @@
+#include <algorithm>
+#include "bitset_selector.h"
+
+ArenaVector<size_t> SelectByBitsets(const SelectionItems &items, int max_carriable_weight)
+{
+    ArenaVector<size_t> bag;
+    const ArenaVector<long long> lightest_sums = LightestWeightSums(items);
+    const int max_count = MaxShipmentCount(lightest_sums, max_carriable_weight);
+
+    if (max_count == 0)
+    {
+        return bag;
+    }
+
+    const size_t cells = static_cast<size_t>(max_carriable_weight) + 1;
+    const size_t words = (cells + 63) >> 6;
+
+    // Level k only matters between the k lightest packages and what is left once the
+    // (max_count - k) lightest ones are set aside for the rest of the shipment.
+    ArenaVector<size_t> low_word(max_count + 1), high_word(max_count + 1);
+    ArenaVector<uint64_t> high_mask(max_count + 1);
+    for (int k = 0; k <= max_count; k++)
+    {
+        size_t ceiling = static_cast<size_t>(max_carriable_weight - lightest_sums[max_count - k]);
+        low_word[k] = static_cast<size_t>(lightest_sums[k]) >> 6;
+        high_word[k] = ceiling >> 6;
+        high_mask[k] = ((ceiling & 63) == 63) ? ~uint64_t{0} : ((uint64_t{1} << ((ceiling & 63) + 1)) - 1);
+    }
+
+    ArenaVector<uint64_t> levels((max_count + 1) * words, 0);
+    ArenaVector<int> top_word(max_count + 1, -1);
+    ArenaVector<int> first_reach((max_count + 1) * cells, -1);
+
+    levels[0] = 1;
+    top_word[0] = 0;
+
+    for (size_t p = 0; p < items.size(); p++)
+    {
+        const int weight = items[p].weight;
+        if (weight < 0 || weight > max_carriable_weight)
+        {
+            continue;
+        }
+
+        const size_t word_shift = static_cast<size_t>(weight) >> 6;
+        const int bit_shift = weight & 63;
+        const int highest_level = static_cast<int>(std::min<size_t>(max_count, p + 1));
+
+        for (int k = highest_level; k >= 1; k--)
+        {
+            if (top_word[k - 1] < 0)
+            {
+                continue;
+            }
+
+            const uint64_t *src = levels.data() + (k - 1) * words;
+            uint64_t *dst = levels.data() + k * words;
+            int *reach = first_reach.data() + k * cells;
+            size_t top = std::min(high_word[k], static_cast<size_t>(top_word[k - 1]) + word_shift + 1);
+            size_t bottom = std::max(low_word[k], word_shift);
+
+            for (size_t d = top + 1; d-- > bottom;)
+            {
+                size_t s = d - word_shift;
+                uint64_t shifted = src[s] << bit_shift;
+                if (bit_shift && s > 0)
+                {
+                    shifted |= src[s - 1] >> (64 - bit_shift);
+                }
+                if (d == high_word[k])
+                {
+                    shifted &= high_mask[k];
+                }
+
+                uint64_t fresh = shifted & ~dst[d];
+                if (fresh)
+                {
+                    dst[d] |= fresh;
+                    top_word[k] = std::max(top_word[k], static_cast<int>(d));
+                    while (fresh)
+                    {
+                        reach[(d << 6) + CountTrailingZeros(fresh)] = static_cast<int>(p);
+                        fresh &= fresh - 1;
+                    }
+                }
+            }
+        }
+    }
+
+    const uint64_t *best_level = levels.data() + max_count * words;
+    int remaining = static_cast<int>(top_word[max_count] << 6) + HighestSetBit(best_level[top_word[max_count]]);
+
+    for (int k = max_count; k >= 1; k--)
+    {
+        const SelectionItem &item = items[first_reach[k * cells + remaining]];
+        bag.push_back(item.idx);
+        remaining -= item.weight;
+    }
+    return bag;
+}
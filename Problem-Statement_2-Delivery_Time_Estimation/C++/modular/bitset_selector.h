@@ -0,0 +1,9 @@
+#pragma once
+
+#include "selection.h"
+
+// Cardinality-indexed subset-sum engine : level k is a bitset of the weights reachable with exactly k packages,
+// and each package ORs level k - 1 shifted by its weight into level k, 64 capacities per instruction.
+// Only levels up to the greedy maximum count are kept. The first package that reached each (k, weight) is
+// recorded, which is all the reconstruction needs, so memory is (count + 1) * (max_carriable_weight + 1) ints.
+ArenaVector<size_t> SelectByBitsets(const SelectionItems &items, int max_carriable_weight);
@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <functional>
+#include "branch_and_bound_selector.h"
+
+namespace
+{
+    struct searchNode
+    {
+        size_t pos;
+        size_t count;
+        long long weight;
+        bool included;
+    };
+
+    const unsigned kNodesPerClockCheck = 4096;
+}
+
+bool SelectByBranchAndBound(const SelectionItems &items, int max_carriable_weight,
+                            std::chrono::microseconds time_budget, ArenaVector<size_t> &bag)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const bool bounded = time_budget != std::chrono::microseconds::max();
+
+    SelectionItems sorted(items);
+    // The items come sorted by index, so ties by index keep them in order as a stable sort would.
+    std::sort(sorted.begin(), sorted.end(),
+              [](const SelectionItem &lhs, const SelectionItem &rhs)
+              {
+                  return lhs.weight > rhs.weight || (lhs.weight == rhs.weight && lhs.idx < rhs.idx);
+              });
+
+    const size_t no_of_items = sorted.size();
+    ArenaVector<long long> prefix(no_of_items + 1, 0);
+    for (size_t i = 0; i < no_of_items; i++)
+    {
+        prefix[i + 1] = prefix[i] + sorted[i].weight;
+    }
+
+    // next_weight[i] is the first position after i holding a lighter package.
+    ArenaVector<size_t> next_weight(no_of_items);
+    for (size_t i = no_of_items; i-- > 0;)
+    {
+        next_weight[i] = (i + 1 < no_of_items && sorted[i + 1].weight == sorted[i].weight) ? next_weight[i + 1] : i + 1;
+    }
+
+    size_t max_count = 0;
+    while (max_count < no_of_items && prefix[no_of_items] - prefix[no_of_items - max_count - 1] <= max_carriable_weight)
+    {
+        max_count++;
+    }
+
+    ArenaVector<size_t> best_path, path;
+    for (size_t i = no_of_items - max_count; i < no_of_items; i++)
+    {
+        best_path.push_back(i);
+    }
+    long long best_weight = prefix[no_of_items] - prefix[no_of_items - max_count];
+
+    ArenaVector<searchNode> stack(1, searchNode{0, 0, 0, false});
+    unsigned nodes = 0;
+    bool complete = true;
+
+    while (!stack.empty() && best_weight < max_carriable_weight)
+    {
+        if (bounded && nodes++ % kNodesPerClockCheck == 0 && std::chrono::steady_clock::now() - start >= time_budget)
+        {
+            complete = false;
+            break;
+        }
+
+        searchNode node = stack.back();
+        stack.pop_back();
+
+        path.resize(node.count);
+        if (node.included)
+        {
+            path.back() = node.pos - 1;
+        }
+
+        const size_t need = max_count - node.count;
+        const long long room = max_carriable_weight - node.weight;
+
+        if (no_of_items - node.pos < need || prefix[no_of_items] - prefix[no_of_items - need] > room)
+        {
+            continue;
+        }
+
+        const long long heaviest = prefix[node.pos + need] - prefix[node.pos];
+        if (node.weight + std::min(heaviest, room) <= best_weight)
+        {
+            continue;
+        }
+
+        // The heaviest completion fits, so it is the best this branch can do.
+        if (heaviest <= room)
+        {
+            best_weight = node.weight + heaviest;
+            best_path = path;
+            for (size_t i = node.pos; i < node.pos + need; i++)
+            {
+                best_path.push_back(i);
+            }
+            continue;
+        }
+
+        // Pushed in reverse, so including the package is explored first.
+        stack.push_back(searchNode{next_weight[node.pos], node.count, node.weight, false});
+        if (sorted[node.pos].weight <= room)
+        {
+            stack.push_back(searchNode{node.pos + 1, node.count + 1, node.weight + sorted[node.pos].weight, true});
+        }
+    }
+
+    bag.clear();
+    for (auto &&pos : best_path)
+    {
+        bag.push_back(sorted[pos].idx);
+    }
+    std::sort(bag.begin(), bag.end(), std::greater<size_t>());
+    return complete;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <chrono>
+#include "selection.h"
+
+// Anytime branch-and-bound selector. The maximal count k* comes from the k* lightest packages, which also seed
+// the best shipment, so any answer it gives already ships as many packages as kp. The search then looks for a
+// heavier k*-package shipment, deciding the packages from heaviest to lightest. A branch is cut when even its
+// lightest completion no longer fits (greedy count bound) or when filling it with its heaviest remaining
+// packages, capped at the capacity (fractional fill bound), cannot beat the best weight. Packages of equal
+// weight are interchangeable, so once one of them is left out the rest of that weight are left out as well.
+//
+// Once time_budget has elapsed the search stops and the best shipment found so far is returned, in which case
+// the function returns false. Returns true when the search proved the shipment weight optimal. The score then
+// matches Delivery::kp, but on ties the bag can hold other packages, so the engine is only used when asked for.
+bool SelectByBranchAndBound(const SelectionItems &items, int max_carriable_weight,
+                            std::chrono::microseconds time_budget, ArenaVector<size_t> &bag);
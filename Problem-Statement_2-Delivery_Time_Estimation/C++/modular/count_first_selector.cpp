@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include "count_first_selector.h"
+
+bool SelectCountFirst(const SelectionItems &items, int max_carriable_weight, long long work_limit, ArenaVector<size_t> &bag)
+{
+    const size_t no_of_items = items.size();
+    ArenaVector<size_t> order(no_of_items);
+    std::iota(order.begin(), order.end(), 0);
+    // Ties are broken by position, as a stable sort would, without its temporary buffer from the global heap.
+    std::sort(order.begin(), order.end(),
+              [&items](size_t lhs, size_t rhs)
+              {
+                  return items[lhs].weight < items[rhs].weight || (items[lhs].weight == items[rhs].weight && lhs < rhs);
+              });
+
+    long long base_weight = 0;
+    size_t max_count = 0;
+    while (max_count < no_of_items && base_weight + items[order[max_count]].weight <= max_carriable_weight)
+    {
+        base_weight += items[order[max_count]].weight;
+        max_count++;
+    }
+
+    if (max_count == 0)
+    {
+        bag.clear();
+        return true;
+    }
+
+    const int threshold = items[order[max_count - 1]].weight;
+    const int slack = static_cast<int>(max_carriable_weight - base_weight);
+
+    ArenaVector<char> in_base(no_of_items, 0);
+    for (size_t k = 0; k < max_count; k++)
+    {
+        in_base[order[k]] = 1;
+    }
+
+    ArenaVector<int> gain(no_of_items);
+    long long base_candidates = 0, outside_candidates = 0;
+    for (size_t p = 0; p < no_of_items; p++)
+    {
+        gain[p] = in_base[p] ? threshold - items[p].weight : items[p].weight - threshold;
+        if (gain[p] <= slack)
+        {
+            (in_base[p] ? base_candidates : outside_candidates)++;
+        }
+    }
+
+    const int span = static_cast<int>(std::min(base_candidates, outside_candidates));
+    const long long rows = 2LL * span + 1, cols = static_cast<long long>(slack) + 1;
+
+    if (span > 0 && (base_candidates + outside_candidates) * rows * cols > work_limit)
+    {
+        return false;
+    }
+
+    // first_reach[(balance + span) * cols + g] : position of the first package after which some swap with that
+    // balance (outside packages added minus base packages removed) and total gain g exists, -1 for the empty swap.
+    const int unreached = std::numeric_limits<int>::max();
+    ArenaVector<int> first_reach(rows * cols, unreached);
+    first_reach[span * cols] = -1;
+
+    for (size_t p = 0; span > 0 && p < no_of_items; p++)
+    {
+        if (gain[p] > slack)
+        {
+            continue;
+        }
+
+        const int direction = in_base[p] ? -1 : 1;
+        const int position = static_cast<int>(p);
+
+        for (int balance = -span; balance <= span; balance++)
+        {
+            int target = balance + direction;
+            if (target < -span || target > span)
+            {
+                continue;
+            }
+
+            const int *src = first_reach.data() + (balance + span) * cols;
+            int *dst = first_reach.data() + (target + span) * cols + gain[p];
+
+            for (int g = 0; g + gain[p] <= slack; g++)
+            {
+                if (src[g] < position && dst[g] == unreached)
+                {
+                    dst[g] = position;
+                }
+            }
+        }
+    }
+
+    int best_gain = 0;
+    for (int g = slack; g >= 0; g--)
+    {
+        if (first_reach[span * cols + g] != unreached)
+        {
+            best_gain = g;
+            break;
+        }
+    }
+
+    auto reachable_before = [&](int balance, int g, size_t p)
+    {
+        return balance >= -span && balance <= span && g >= 0 &&
+               first_reach[(balance + span) * cols + g] < static_cast<int>(p);
+    };
+
+    bag.clear();
+    int balance = 0, remaining_gain = best_gain;
+
+    for (size_t p = no_of_items; p-- > 0;)
+    {
+        if (gain[p] > slack)
+        {
+            if (in_base[p])
+            {
+                bag.push_back(items[p].idx);
+            }
+        }
+        else if (in_base[p])
+        {
+            if (reachable_before(balance + 1, remaining_gain - gain[p], p))
+            {
+                balance++;
+                remaining_gain -= gain[p];
+            }
+            else
+            {
+                bag.push_back(items[p].idx);
+            }
+        }
+        else if (!reachable_before(balance, remaining_gain, p))
+        {
+            bag.push_back(items[p].idx);
+            balance--;
+            remaining_gain -= gain[p];
+        }
+    }
+    return true;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "selection.h"
+
+// Count-first selector. The largest shipment count k* is fixed by the k* lightest packages (the "base" set),
+// leaving slack = max_carriable_weight - weight(base). Every other k*-package shipment swaps some base packages
+// for the same number of outside ones. Measured against the heaviest base weight t, removing a base package r
+// gains t - r >= 0 and adding an outside package a gains a - t >= 0, and for a balanced swap the gains add up
+// to the extra weight over the base. So only the (balance, gain <= slack) window needs a DP, rather than the
+// whole capacity row. The first package reaching each (balance, gain) is kept so the kp bag can be rebuilt.
+//
+// Returns false, leaving bag untouched, when that window would cost more than work_limit cell updates.
+bool SelectCountFirst(const SelectionItems &items, int max_carriable_weight, long long work_limit, ArenaVector<size_t> &bag);
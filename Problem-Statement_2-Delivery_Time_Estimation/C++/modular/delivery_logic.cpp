@@ -4,10 +4,20 @@
 #include <chrono>
 #include <iomanip>
 #include <queue>
+#include <limits>
+#include <cmath>
 #include "delivery_logic.h"
+#include "shipment_cache.h"
+#include "parallel_kp.h"
+#include "tiled_kp.h"
+#include "linear_memory_selector.h"
+#include "fixed_capacity_selector.h"
+#include "two_constraint_selector.h"
 
 std::unordered_map<std::string, Offer> Delivery::_offers = std::unordered_map<std::string, Offer>();
 
+thread_local std::vector<size_t> Delivery::_itemsScanned;
+
 std::string Delivery::buildDateTimeString()
 {
     auto sys_clock = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
@@ -26,26 +36,154 @@ std::ofstream Delivery::_logFile = []
     return std::ofstream(std::move(fileName));
 }();
 
-void Delivery::kp(std::vector<compositeValue> &compositeObjects,
+auto Delivery::kp(SelectionItems &items,
                   int max_carriable_weight,
-                  std::vector<bool> &availability,
-                  std::vector<compositeValue> &availableComputations)
+                  SelectionScratch &scratch,
+                  const SelectionOptions &options) -> ArenaVector<size_t>
 {
-    for (size_t i = 1; i <= compositeObjects.size(); i++)
+
+    ArenaVector<size_t> bag;
+    if (options.fixed_capacities && SelectFixedCapacity(items, max_carriable_weight, bag))
+    {
+        return bag;
+    }
+    if (DecisionBytes(items.size(), max_carriable_weight) > options.decision_budget)
     {
-        if (availability[i - 1])
+        SelectWithLinearMemory(items, max_carriable_weight, options.decision_budget, bag);
+        return bag;
+    }
+
+    scratch.scores.assign(max_carriable_weight + 1, 0);
+    scratch.decisions.resize(items.size(), max_carriable_weight);
+
+    const size_t no_of_threads = ParallelSweepThreads(max_carriable_weight, options.threads);
+    if (no_of_threads > 1)
+    {
+        ParallelRelaxScores(items, max_carriable_weight, scratch.scores, scratch.spare, scratch.decisions.row(0),
+                            scratch.decisions.words_per_item, no_of_threads);
+    }
+    else if (options.tiled_sweep && max_carriable_weight >= kTiledMinCapacity)
+    {
+        TiledRelaxScores(items, max_carriable_weight, scratch.scores.data(), scratch.decisions.row(0), scratch.decisions.words_per_item, TiledBlockCells());
+    }
+    else
+    {
+        for (size_t i = 0; i < items.size(); i++)
         {
-            for (size_t j = max_carriable_weight; j >= compositeObjects[i - 1].GetWeight(); j--)
-            {
-                compositeValue np;
-                np = std::move(availableComputations[j - compositeObjects[i - 1].GetWeight()] + compositeObjects[i - 1]);
-                if (np > availableComputations[j])
-                {
-                    availableComputations[j] = std::move(np);
-                }
-            }
+            scratch.decisions.clear(i);
+            RelaxScores(scratch.scores.data(), scratch.decisions.row(i), max_carriable_weight, items[i].weight);
+        }
+    }
+
+    int capacity = max_carriable_weight;
+
+    for (size_t i = items.size(); i > 0; i--)
+    {
+        if (scratch.decisions.test(i - 1, capacity))
+        {
+            bag.push_back(items[i - 1].idx);
+            capacity -= items[i - 1].weight;
+        }
+    }
+    return bag;
+}
+
+auto Delivery::selectShipment(const SelectionOptions &options,
+                              const WaitingPackages &waiting,
+                              int max_carriable_weight,
+                              SelectionScratch &scratch,
+                              SelectionDecision &decision) -> ArenaVector<size_t>
+{
+    // Weight classes prefers the nearest packages of a weight, so it still needs every waiting one.
+    auto items = options.engine == SelectionEngine::WeightClasses ? waiting.All() : waiting.Candidates(max_carriable_weight);
+
+    if (options.shipment_cache > 0 && ReturnsKpBag(options.engine))
+    {
+        auto &cache = SharedShipmentCache(options.shipment_cache);
+        ArenaVector<size_t> bag;
+        if (cache.Find(max_carriable_weight, items, bag))
+        {
+            decision = SelectionDecision();
+            decision.engine = "cache";
+            decision.items = items.size();
+            return bag;
+        }
+
+        // The engines compress the weights in place, the cache is keyed by the real ones.
+        SelectionItems compressed(items);
+        bag = selectUncached(options, compressed, max_carriable_weight, scratch, decision);
+        cache.Insert(max_carriable_weight, items, bag);
+        return bag;
+    }
+    return selectUncached(options, items, max_carriable_weight, scratch, decision);
+}
+
+auto Delivery::selectUncached(const SelectionOptions &options,
+                              SelectionItems &items,
+                              int max_carriable_weight,
+                              SelectionScratch &scratch,
+                              SelectionDecision &decision) -> ArenaVector<size_t>
+{
+    ArenaVector<size_t> bag;
+    const int capacity = CompressCapacity(items, max_carriable_weight);
+
+    // A forced engine that gives up, past its limits or its accuracy, hands the round to the cost model.
+    const ShipmentSelector *forced = options.engine == SelectionEngine::Auto ? nullptr : Selectors().Find(options.engine);
+    if (forced && forced->Select(items, capacity, options, std::numeric_limits<double>::infinity(), scratch, bag))
+    {
+        decision = SelectionDecision();
+        decision.engine = forced->Name();
+        decision.items = items.size();
+        if (options.metrics)
+        {
+            decision.cost = forced->EstimateCost(ProfileSelection(items, capacity), options);
+        }
+        return bag;
+    }
+
+    Selectors().SelectCheapest(items, capacity, options, scratch, bag, decision);
+    return bag;
+}
+
+// The dense kp behind the ShipmentSelector interface. It relaxes every package over the whole row, keeping one
+// decision bit per package and capacity unless that exceeds the decision budget.
+class DenseDpSelector : public ShipmentSelector
+{
+public:
+    SelectionEngine Engine() const override { return SelectionEngine::DenseDP; }
+    const char *Name() const override { return "dense"; }
+
+    SelectionCost EstimateCost(const SelectionProfile &profile, const SelectionOptions &options) const override
+    {
+        const double cells = profile.items * (profile.capacity + 1.0);
+        const double decision_bytes = static_cast<double>(DecisionBytes(profile.items, profile.capacity));
+        if (decision_bytes <= options.decision_budget)
+        {
+            return SelectionCost{cells, (profile.capacity + 1.0) * sizeof(uint64_t) + decision_bytes};
         }
+        // The linear-memory sweep halves the packages until their decisions fit, sweeping them once per level.
+        const double levels = std::ceil(std::log2(decision_bytes / std::max<size_t>(options.decision_budget, 1))) + 1;
+        return SelectionCost{cells * levels, (profile.capacity + 1.0) * sizeof(uint64_t) * levels + options.decision_budget};
+    }
+
+    bool Select(SelectionItems &items, int capacity, const SelectionOptions &options, double, SelectionScratch &scratch,
+                ArenaVector<size_t> &bag) const override
+    {
+        bag = Delivery::kp(items, capacity, scratch, options);
+        return true;
     }
+};
+
+auto Delivery::Selectors() -> const SelectorRegistry &
+{
+    static const SelectorRegistry registry = []
+    {
+        SelectorRegistry selectors;
+        selectors.Register(std::unique_ptr<ShipmentSelector>(new DenseDpSelector));
+        RegisterStandardSelectors(selectors);
+        return selectors;
+    }();
+    return registry;
 }
 
 void Delivery::SetUpDelivery(std::string filePath, bool useFileLogging, std::ostream &out)
@@ -73,7 +211,7 @@ void Delivery::ReloadOffers(std::string filePath)
     _offers = std::move(IngestOffers(filePath, _logFile));
 }
 
-void Delivery::ExecuteWorkflow(std::istream &is, std::ostream &os)
+void Delivery::ExecuteWorkflow(std::istream &is, std::ostream &os, const SelectionOptions &options)
 {
     long long base_delivery_cost = 0;
     int no_of_packages = 0, pkg_weight_in_kg = 0, pkg_distance_in_km = 0;
@@ -82,12 +220,45 @@ void Delivery::ExecuteWorkflow(std::istream &is, std::ostream &os)
     is >> base_delivery_cost >> no_of_packages;
 
     std::vector<Package> packages;
+    packages.reserve(no_of_packages);
+
+    // Every line may end with optional columns : a package's volume and group, and a vehicle's volume and parcel
+    // limits. A missing line reads as an empty one.
+    std::string line;
+    std::istringstream fields;
+    const auto next_line = [&is, &line, &fields]() -> std::istringstream &
+    {
+        line.clear();
+        std::getline(is >> std::ws, line);
+        fields.clear();
+        fields.str(line);
+        return fields;
+    };
 
     for (size_t i = 0; i < no_of_packages; i++)
     {
-        is >> pkg_id >> pkg_weight_in_kg >> pkg_distance_in_km >> offer_id;
+        // A short line leaves its missing fields empty, not at the values of the line before it.
+        pkg_id.clear();
+        offer_id.clear();
+        pkg_weight_in_kg = pkg_distance_in_km = 0;
+        next_line() >> pkg_id >> pkg_weight_in_kg >> pkg_distance_in_km >> offer_id;
         Package pkg(pkg_id, pkg_weight_in_kg, pkg_distance_in_km);
 
+        // A numeric 5th column is the volume and the group may follow it, any other 5th column is the group.
+        int pkg_volume = 0;
+        std::string column;
+        if (fields >> column)
+        {
+            std::istringstream number(column);
+            if (number >> pkg_volume && number.eof())
+            {
+                pkg.setVolume(pkg_volume);
+                column.clear();
+                fields >> column;
+            }
+            pkg.setGroupId(column);
+        }
+
         auto offer = _offers.find(offer_id);
 
         if (offer != _offers.end())
@@ -102,12 +273,20 @@ void Delivery::ExecuteWorkflow(std::istream &is, std::ostream &os)
         packages.emplace_back(std::move(pkg));
     }
 
-    int no_of_vehicles = 0, max_speed = 0, max_carriable_weight = 0;
+    // Every further vehicle line adds a class of vehicles with its own speed, capacity and limits.
+    std::vector<Vehicle> fleet;
+    int no_of_vehicles = 0;
+    Vehicle vehicle{0, 0, VehicleLimits()};
 
-    is >> no_of_vehicles >> max_speed >> max_carriable_weight;
+    while (next_line() >> no_of_vehicles >> vehicle.max_speed >> vehicle.max_carriable_weight)
+    {
+        vehicle.limits = VehicleLimits();
+        fields >> vehicle.limits.max_volume >> vehicle.limits.max_parcels;
+        fleet.insert(fleet.end(), std::max(no_of_vehicles, 0), vehicle);
+    }
 
     // Delivery_Time(packages, no_of_vehicles, max_speed, max_carriable_weight);
-    Delivery_Time(packages, no_of_vehicles, max_speed, max_carriable_weight);
+    Delivery_Time(packages, fleet, options);
 
     for (size_t i = 0; i < packages.size(); i++)
     {
@@ -115,43 +294,322 @@ void Delivery::ExecuteWorkflow(std::istream &is, std::ostream &os)
     }
 }
 
-void Delivery::Delivery_Time(std::vector<Package> &packages, int no_of_vehicles, int max_speed, int max_carriable_weight)
+void Delivery::Delivery_Time(std::vector<Package> &packages, int no_of_vehicles, int max_speed, int max_carriable_weight,
+                             const SelectionOptions &options)
+{
+    Delivery_Time(packages, no_of_vehicles, max_speed, max_carriable_weight, VehicleLimits(), options);
+}
+
+void Delivery::Delivery_Time(std::vector<Package> &packages, int no_of_vehicles, int max_speed, int max_carriable_weight,
+                             const VehicleLimits &limits, const SelectionOptions &options)
 {
-    int no_of_packages = 0;
-    std::vector<compositeValue> availableComputations(max_carriable_weight + 1, compositeValue());
-    std::vector<bool> availability = std::move(buildAvailability(packages, max_carriable_weight, no_of_packages));
+    Delivery_Time(packages, std::vector<Vehicle>(std::max(no_of_vehicles, 0), Vehicle{max_speed, max_carriable_weight, limits}), options);
+}
+
+void Delivery::Delivery_Time(std::vector<Package> &packages, const std::vector<Vehicle> &fleet, const SelectionOptions &options)
+{
+    // The queues live for the whole call, everything a round builds is dropped with the round.
+    PlanningArena plan_arena, round_arena;
+    PlanningArena::Scope plan_scope(options.planning_arena ? &plan_arena : nullptr);
 
-    auto agent_queue = std::move(get_agent_queue(no_of_vehicles));
-    auto compositeObjects = std::move(get_pre_computed_composite_objects(packages));
+    SelectionScratch scratch;
+    WaitingPackages waiting(packages, fleet);
+    const PackageGroups groups(packages);
 
-    while (no_of_packages)
+    // Per package values of the other objectives, see objective_selector.h.
+    const bool count_then_weight = options.objective == SelectionObjective::CountThenWeight;
+    std::vector<int> priorities, revenue;
+    if (!count_then_weight)
     {
-        kp(compositeObjects, max_carriable_weight, availability, availableComputations);
-        auto &best = availableComputations[max_carriable_weight];
+        std::vector<long long> priority_values, revenue_values;
+        for (auto &&package : packages)
+        {
+            const double cents = package.getCost() * 100;
+            priority_values.push_back(std::max(package.getPriority(), 0));
+            revenue_values.push_back(cents > 0 ? std::llround(std::min(cents, static_cast<double>(std::numeric_limits<int32_t>::max()))) : 0);
+        }
+        priorities = ObjectiveScores(priority_values);
+        revenue = ObjectiveScores(revenue_values);
+    }
+
+    auto agent_queue = std::move(get_agent_queue(fleet.size()));
+
+    // Other engines may ship other packages of the same weights than kp, so they only skip the forced rounds.
+    const bool lightest_first = ReturnsKpBag(options.engine);
 
-        sort(best.bag.begin(), best.bag.end(),
-             [&packages](const int pkg1, const int pkg2)
-             {
-                 return packages[pkg1].getDistance() < packages[pkg2].getDistance();
-             });
+    // The last best shipment, when it left and how much its vehicle carries, for options.pack_free_vehicles.
+    ArenaVector<size_t> last_shipment;
+    int last_shipped_at = -1, last_capacity = -1;
 
-        int available_agent = agent_queue.top(), max_agent_busy_time = 0;
+    // A round ships at least one package or retires a vehicle.
+    _itemsScanned.clear();
+    _itemsScanned.reserve(waiting.size() + fleet.size());
 
-        for (auto &&idx : best.bag)
+    while (waiting.size() && !agent_queue.empty())
+    {
         {
-            availability[idx] = false;
-            max_agent_busy_time = available_agent + ((static_cast<long long>(packages[idx].getDistance()) * 100) / max_speed);
-            packages[idx].setDeliveryTime(static_cast<float>(max_agent_busy_time) / 100);
+            PlanningArena::Scope round_scope(options.planning_arena ? &round_arena : nullptr);
+
+            // Every vehicle free as early as the first one may take this round.
+            const int available_agent = agent_queue.top().first;
+            ArenaVector<size_t> free_vehicles;
+            while (!agent_queue.empty() && agent_queue.top().first == available_agent)
+            {
+                free_vehicles.push_back(agent_queue.top().second);
+                agent_queue.pop();
+            }
+
+            const size_t scanned_before = waiting.ItemsScanned();
+            ArenaVector<size_t> best;
+            SelectionDecision decision;
+            decision.engine = "trivial";
+
+            size_t vehicle = free_vehicles.front();
+            if (!selectForFleet(options, waiting, fleet, free_vehicles, groups.empty() && count_then_weight, scratch, vehicle, decision, best))
+            {
+                const Vehicle &selected = fleet[vehicle];
+                if (selected.limits.Any())
+                {
+                    best = selectWithinLimits(waiting, selected.max_carriable_weight, selected.limits, groups, decision);
+                }
+                else if (!groups.empty())
+                {
+                    SelectionItems items = waiting.All();
+                    decision.engine = "groups";
+                    decision.items = items.size();
+                    SelectGroups(items, groups, selected.max_carriable_weight, scratch, best);
+                }
+                else if (!count_then_weight)
+                {
+                    best = selectByObjective(options, waiting, selected.max_carriable_weight, priorities, revenue, scratch, decision);
+                }
+                else if (options.pack_free_vehicles && available_agent == last_shipped_at &&
+                         selected.max_carriable_weight == last_capacity && waiting.RepeatShipment(last_shipment, best))
+                {
+                    decision.engine = "repeat";
+                    decision.items = best.size();
+                }
+                else if (!options.trivial_rounds || !waiting.TrivialShipment(selected.max_carriable_weight, lightest_first, best))
+                {
+                    best = selectShipment(options, waiting, selected.max_carriable_weight, scratch, decision);
+                }
+            }
+            waiting.Remove(best);
+            if (options.pack_free_vehicles && ReturnsKpBag(options.engine) && count_then_weight && !fleet[vehicle].limits.Any() && !best.empty())
+            {
+                last_shipment.assign(best.begin(), best.end());
+                last_shipped_at = available_agent;
+                last_capacity = fleet[vehicle].max_carriable_weight;
+            }
+            _itemsScanned.push_back(waiting.ItemsScanned() - scanned_before);
+
+            if (options.metrics)
+            {
+                *options.metrics << "Round " << _itemsScanned.size() << " : " << decision.engine << ", " << decision.items
+                                 << " candidates, estimated " << decision.cost.work << " cells and " << decision.cost.bytes
+                                 << " bytes, " << best.size() << " shipped, " << _itemsScanned.back() << " items scanned, vehicle "
+                                 << vehicle << '\n';
+            }
+
+            sort(best.begin(), best.end(),
+                 [&packages](const int pkg1, const int pkg2)
+                 {
+                     return packages[pkg1].getDistance() < packages[pkg2].getDistance();
+                 });
+
+            const int max_speed = fleet[vehicle].max_speed;
+            int max_agent_busy_time = 0;
+
+            for (auto &&idx : best)
+            {
+                max_agent_busy_time = available_agent + ((static_cast<long long>(packages[idx].getDistance()) * 100) / max_speed);
+                packages[idx].setDeliveryTime(static_cast<float>(max_agent_busy_time) / 100);
+            }
+
+            for (auto &&other : free_vehicles)
+            {
+                if (other != vehicle)
+                {
+                    agent_queue.push(std::make_pair(available_agent, other));
+                }
+            }
+            // Nothing left fits a vehicle that shipped nothing, the packages only get fewer.
+            if (!best.empty())
+            {
+                agent_queue.push(std::make_pair(max_agent_busy_time * 2, vehicle));
+            }
+        }
+        round_arena.Release();
+    }
+}
+
+bool Delivery::selectForFleet(const SelectionOptions &options,
+                              const WaitingPackages &waiting,
+                              const std::vector<Vehicle> &fleet,
+                              const ArenaVector<size_t> &free_vehicles,
+                              bool fleet_sweep,
+                              SelectionScratch &scratch,
+                              size_t &vehicle,
+                              SelectionDecision &decision,
+                              ArenaVector<size_t> &bag)
+{
+    // Limits make the vehicles incomparable without solving each one, the first free vehicle goes.
+    int largest = 0;
+    bool same_capacity = true;
+    for (auto &&free_vehicle : free_vehicles)
+    {
+        if (fleet[free_vehicle].limits.Any())
+        {
+            vehicle = free_vehicles.front();
+            return false;
         }
+        largest = std::max(largest, fleet[free_vehicle].max_carriable_weight);
+        same_capacity &= fleet[free_vehicle].max_carriable_weight == fleet[free_vehicles.front()].max_carriable_weight;
+    }
 
-        agent_queue.pop();
-        agent_queue.push(max_agent_busy_time * 2);
+    const auto faster = [&fleet](size_t lhs, size_t rhs)
+    {
+        return fleet[lhs].max_speed > fleet[rhs].max_speed;
+    };
+    if (same_capacity)
+    {
+        vehicle = *std::min_element(free_vehicles.begin(), free_vehicles.end(), faster);
+        return false;
+    }
+    // The sweep below only knows ungrouped packages ranked by count and then weight.
+    if (!fleet_sweep)
+    {
+        vehicle = free_vehicles.front();
+        return false;
+    }
 
-        no_of_packages -= best.bag.size();
+    // A kp row up to the largest capacity holds the best score of every smaller one, and candidates drawn for the
+    // largest include those of every smaller one, so one sweep answers each vehicle.
+    SelectionItems items = waiting.Candidates(largest);
+    int divisor = 1;
+    const int capacity = CompressCapacity(items, largest, divisor);
+    const bool keep_decisions = ReturnsKpBag(options.engine) && DecisionBytes(items.size(), capacity) <= options.decision_budget;
 
-        for (auto &&ac : availableComputations)
+    scratch.scores.assign(capacity + 1, 0);
+    scratch.decisions.resize(keep_decisions ? items.size() : 1, capacity);
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        const size_t row = keep_decisions ? i : 0;
+        scratch.decisions.clear(row);
+        RelaxScores(scratch.scores.data(), scratch.decisions.row(row), capacity, items[i].weight);
+    }
+
+    const auto row_of = [&fleet, divisor, capacity](size_t free_vehicle)
+    {
+        return std::min(fleet[free_vehicle].max_carriable_weight / divisor, capacity);
+    };
+    uint64_t best_score = 0;
+    for (auto &&free_vehicle : free_vehicles)
+    {
+        best_score = std::max(best_score, scratch.scores[row_of(free_vehicle)]);
+    }
+
+    bool found = false;
+    for (auto &&free_vehicle : free_vehicles)
+    {
+        if (scratch.scores[row_of(free_vehicle)] != best_score)
+        {
+            continue;
+        }
+        const int weight = fleet[free_vehicle].max_carriable_weight, chosen = fleet[vehicle].max_carriable_weight;
+        if (!found || weight < chosen || (weight == chosen && faster(free_vehicle, vehicle)))
         {
-            ac.reset();
+            vehicle = free_vehicle;
+            found = true;
         }
     }
-}
\ No newline at end of file
+
+    if (!keep_decisions)
+    {
+        return false;
+    }
+    decision = SelectionDecision();
+    decision.engine = "fleet";
+    decision.items = items.size();
+
+    // The walk back from a smaller capacity only reads cells no larger, which a sweep up to it alone would fill alike.
+    bag.clear();
+    int remaining = row_of(vehicle);
+    for (size_t i = items.size(); i > 0; i--)
+    {
+        if (scratch.decisions.test(i - 1, remaining))
+        {
+            bag.push_back(items[i - 1].idx);
+            remaining -= items[i - 1].weight;
+        }
+    }
+    return true;
+}
+
+auto Delivery::selectByObjective(const SelectionOptions &options,
+                                 const WaitingPackages &waiting,
+                                 int max_carriable_weight,
+                                 const std::vector<int> &priorities,
+                                 const std::vector<int> &revenue,
+                                 SelectionScratch &scratch,
+                                 SelectionDecision &decision) -> ArenaVector<size_t>
+{
+    // Packages of the same weight no longer score alike, so every waiting one is a candidate.
+    SelectionItems items = waiting.All();
+    decision.engine = "objective";
+    decision.items = items.size();
+
+    ArenaVector<size_t> bag;
+    if (options.objective == SelectionObjective::PriorityThenWeight)
+    {
+        SelectByObjective(items, max_carriable_weight, PriorityThenWeight{priorities.data()}, scratch, bag);
+    }
+    else
+    {
+        SelectByObjective(items, max_carriable_weight, RevenueThenWeight{revenue.data()}, scratch, bag);
+    }
+    return bag;
+}
+
+auto Delivery::selectWithinLimits(const WaitingPackages &waiting,
+                                  int max_carriable_weight,
+                                  const VehicleLimits &limits,
+                                  const PackageGroups &groups,
+                                  SelectionDecision &decision) -> ArenaVector<size_t>
+{
+    // Swapping a package for a lower index of the same weight can overflow the volume, so only a parcel limit keeps
+    // to the first packages of each weight. Grouped packages are left to vehicles without limits, and the first
+    // packages of a weight may be among them.
+    SelectionItems items = limits.max_volume > 0 || !groups.empty() ? waiting.All() : waiting.Candidates(max_carriable_weight);
+    items.erase(std::remove_if(items.begin(), items.end(),
+                               [&groups](const SelectionItem &item)
+                               {
+                                   return groups.GroupOf(item.idx) != PackageGroups::kNoGroup;
+                               }),
+                items.end());
+    decision.engine = "two-constraint";
+    decision.items = items.size();
+
+    ArenaVector<size_t> bag;
+    SelectWithVehicleLimits(items, max_carriable_weight, limits, bag);
+    return bag;
+}
+
+auto Delivery::ItemsScannedPerRound() -> const std::vector<size_t> &
+{
+    return _itemsScanned;
+}
+
+auto Delivery::SelectShipment(std::vector<Package> &packages, int max_carriable_weight,
+                              const SelectionOptions &options) -> std::vector<size_t>
+{
+    PlanningArena arena;
+    PlanningArena::Scope scope(options.planning_arena ? &arena : nullptr);
+
+    SelectionScratch scratch;
+    WaitingPackages waiting(packages, max_carriable_weight);
+
+    SelectionDecision decision;
+    auto bag = selectShipment(options, waiting, max_carriable_weight, scratch, decision);
+    return std::vector<size_t>(bag.begin(), bag.end());
+}
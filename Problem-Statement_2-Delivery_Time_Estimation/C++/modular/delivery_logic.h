@@ -3,143 +3,119 @@
 #include <functional>
 #include <queue>
 #include <fstream>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
 #include "offer.h"
 #include "package.h"
+#include "kp_kernel.h"
+#include "selection.h"
+#include "waiting_packages.h"
+#include "vehicle.h"
+#include "shipment_selector.h"
+#include "group_selector.h"
+#include "objective_selector.h"
 
 class Delivery
 {
-    struct compositeValue
-    {
-        int weight;
-        int count;
-        std::vector<size_t> bag;
-
-        compositeValue(int wt, int ct, size_t itemIdx) : weight{wt}, count{ct}
-        {
-            bag = std::move(std::vector<size_t>(1, itemIdx));
-        }
-        compositeValue() : weight{0}, count{0}, bag{std::move(std::vector<size_t>())} {}
-
-        compositeValue(const compositeValue &other)
-        {
-            weight = other.weight;
-            count = other.count;
-            bag = std::vector<size_t>();
-            for (auto &&i : other.bag)
-            {
-                bag.push_back(i);
-            }
-        }
-
-        compositeValue(compositeValue &&other)
-        {
-            weight = other.weight;
-            count = other.count;
-            bag = std::move(other.bag);
-        }
-
-        int GetWeight() { return weight; }
-
-        void reset()
-        {
-            weight = 0;
-            count = 0;
-            bag.clear();
-        }
-
-        bool operator>(const compositeValue &other)
-        {
-            if (count > other.count)
-                return true;
-            else if (count == other.count && weight > other.weight)
-                return true;
-            else
-                return false;
-        }
-
-        void operator=(const compositeValue &other) = delete;
-
-        void operator=(compositeValue &&other)
-        {
-            weight = other.weight;
-            count = other.count;
-            bag = std::move(other.bag);
-        }
-
-        compositeValue operator+(const compositeValue &other)
-        {
-            compositeValue nv;
-            nv.weight = weight + other.weight;
-            nv.count = count + other.count;
-            for (auto &&i : other.bag)
-            {
-                nv.bag.push_back(i);
-            }
-            for (auto &&i : bag)
-            {
-                nv.bag.push_back(i);
-            }
-
-            return nv;
-        }
-    };
-
     static std::unordered_map<std::string, Offer> _offers;
 
     static std::ofstream _logFile;
 
+    static thread_local std::vector<size_t> _itemsScanned;
+
     static std::string buildDateTimeString();
 
-    static auto get_agent_queue(int no_of_vehicles) -> std::priority_queue<int, std::vector<int>, std::greater<int>>
+    // (time the vehicle is free, vehicle), the earliest and then the first vehicle on top.
+    using agentQueue = std::priority_queue<std::pair<int, size_t>, std::vector<std::pair<int, size_t>>, std::greater<std::pair<int, size_t>>>;
+
+    static auto get_agent_queue(size_t no_of_vehicles) -> agentQueue
     {
-        std::priority_queue<int, std::vector<int>, std::greater<int>> agent_queue;
+        agentQueue agent_queue;
 
         for (size_t i = 0; i < no_of_vehicles; i++)
         {
-            agent_queue.push(0);
+            agent_queue.push(std::make_pair(0, i));
         }
         return agent_queue;
     }
 
-    static auto get_pre_computed_composite_objects(std::vector<Package> &packages) -> std::vector<compositeValue>
-    {
-        std::vector<compositeValue> compositeObjects;
-
-        for (size_t i = 0; i < packages.size(); i++)
-        {
-            compositeObjects.push_back(compositeValue(packages[i].getWeight(), 1, i));
-        }
-        return compositeObjects;
-    }
-
-    static auto buildAvailability(std::vector<Package> &packages, int max_carriable_weight, int &no_of_packages) -> std::vector<bool>
-    {
-        std::vector<bool> availability(packages.size(), false);
-
-        for (size_t i = 0; i < packages.size(); i++)
-        {
-            if (packages[i].getWeight() <= max_carriable_weight)
-            {
-                availability[i] = true;
-                no_of_packages++;
-            }
-        }
-        return availability;
-    }
-
-    static void kp(std::vector<compositeValue> &compositeObjects,
+    static auto kp(SelectionItems &items,
                    int max_carriable_weight,
-                   std::vector<bool> &availability,
-                   std::vector<compositeValue> &availableComputations);
+                   SelectionScratch &scratch,
+                   const SelectionOptions &options = SelectionOptions()) -> ArenaVector<size_t>;
+
+    static auto selectShipment(const SelectionOptions &options,
+                               const WaitingPackages &waiting,
+                               int max_carriable_weight,
+                               SelectionScratch &scratch,
+                               SelectionDecision &decision) -> ArenaVector<size_t>;
+
+    static auto selectUncached(const SelectionOptions &options,
+                               SelectionItems &items,
+                               int max_carriable_weight,
+                               SelectionScratch &scratch,
+                               SelectionDecision &decision) -> ArenaVector<size_t>;
+
+    static auto selectWithinLimits(const WaitingPackages &waiting,
+                                   int max_carriable_weight,
+                                   const VehicleLimits &limits,
+                                   const PackageGroups &groups,
+                                   SelectionDecision &decision) -> ArenaVector<size_t>;
+
+    static auto selectByObjective(const SelectionOptions &options,
+                                  const WaitingPackages &waiting,
+                                  int max_carriable_weight,
+                                  const std::vector<int> &priorities,
+                                  const std::vector<int> &revenue,
+                                  SelectionScratch &scratch,
+                                  SelectionDecision &decision) -> ArenaVector<size_t>;
+
+    static bool selectForFleet(const SelectionOptions &options,
+                               const WaitingPackages &waiting,
+                               const std::vector<Vehicle> &fleet,
+                               const ArenaVector<size_t> &free_vehicles,
+                               bool fleet_sweep,
+                               SelectionScratch &scratch,
+                               size_t &vehicle,
+                               SelectionDecision &decision,
+                               ArenaVector<size_t> &bag);
+
+    friend class DenseDpSelector;
 
 public:
     static void SetUpDelivery(std::string filePath = "json_files\\offers.json", bool useFileLogging = true, std::ostream &out = std::cout);
 
     static void TearDownDelivery();
 
-    static void ExecuteWorkflow(std::istream &is = std::cin, std::ostream &os = std::cout);
+    static void ExecuteWorkflow(std::istream &is = std::cin, std::ostream &os = std::cout,
+                                const SelectionOptions &options = SelectionOptions());
 
     static void ReloadOffers(std::string filePath);
 
-    static void Delivery_Time(std::vector<Package> &packages, int no_of_vehicles, int max_speed, int max_carriable_weight);
+    static void Delivery_Time(std::vector<Package> &packages, int no_of_vehicles, int max_speed, int max_carriable_weight,
+                              const SelectionOptions &options = SelectionOptions());
+
+    // Same, with every vehicle also bound by limits. Packages bulkier than limits.max_volume are never shipped.
+    static void Delivery_Time(std::vector<Package> &packages, int no_of_vehicles, int max_speed, int max_carriable_weight,
+                              const VehicleLimits &limits, const SelectionOptions &options = SelectionOptions());
+
+    // Plans for a mixed fleet, every vehicle with its own speed, capacity and limits. Packages no vehicle can take
+    // are never shipped, and a vehicle that can take none of the packages left is not sent out again.
+    // When vehicles of different capacities are free at once, one kp row up to the largest capacity gives the best
+    // shipment of each, and the smallest vehicle matching the best of them goes, the fastest on a tie.
+    // Packages sharing a group id ship together through SelectGroups (group_selector.h), and only on vehicles
+    // without limits. Other vehicles maximise options.objective through SelectByObjective (objective_selector.h).
+    static void Delivery_Time(std::vector<Package> &packages, const std::vector<Vehicle> &fleet,
+                              const SelectionOptions &options = SelectionOptions());
+
+    // Every selection engine, the dense kp first. --engine and SelectionOptions::engine pick one of them, Auto lets
+    // the cost model of shipment_selector.h pick per round.
+    static auto Selectors() -> const SelectorRegistry &;
+
+    // Waiting packages each round of the last Delivery_Time on this thread read while picking and removing its shipment.
+    static auto ItemsScannedPerRound() -> const std::vector<size_t> &;
+
+    static auto SelectShipment(std::vector<Package> &packages, int max_carriable_weight,
+                               const SelectionOptions &options = SelectionOptions()) -> std::vector<size_t>;
 };
\ No newline at end of file
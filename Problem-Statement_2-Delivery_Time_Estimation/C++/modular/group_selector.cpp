@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include "package.h"
+#include "kp_kernel.h"
+#include "group_selector.h"
+
+const size_t PackageGroups::kNoGroup = std::numeric_limits<size_t>::max();
+
+PackageGroups::PackageGroups(std::vector<Package> &packages) : group_of(packages.size(), kNoGroup)
+{
+    std::unordered_map<std::string, size_t> ids;
+    for (size_t i = 0; i < packages.size(); i++)
+    {
+        const std::string group = packages[i].getGroupId();
+        if (group.empty())
+        {
+            continue;
+        }
+
+        auto found = ids.emplace(group, members.size());
+        if (found.second)
+        {
+            members.emplace_back();
+        }
+        group_of[i] = found.first->second;
+        members[group_of[i]].push_back(i);
+    }
+}
+
+void SelectGroups(const SelectionItems &items, const PackageGroups &groups, int max_carriable_weight,
+                  SelectionScratch &scratch, ArenaVector<size_t> &bag)
+{
+    struct groupItem
+    {
+        size_t idx;
+        size_t group;
+        long long weight;
+        int count;
+    };
+
+    // Every group becomes one item, at its first package.
+    ArenaVector<groupItem> collapsed;
+    std::unordered_map<size_t, size_t> slot_of_group;
+    for (auto &&item : items)
+    {
+        const size_t group = groups.GroupOf(item.idx);
+        if (group == PackageGroups::kNoGroup)
+        {
+            collapsed.push_back(groupItem{item.idx, group, item.weight, 1});
+            continue;
+        }
+
+        auto found = slot_of_group.emplace(group, collapsed.size());
+        if (found.second)
+        {
+            collapsed.push_back(groupItem{item.idx, group, 0, 0});
+        }
+        collapsed[found.first->second].weight += item.weight;
+        collapsed[found.first->second].count++;
+    }
+
+    // A group with a package no vehicle takes never left the waiting list complete, it cannot ship.
+    ArenaVector<size_t> order;
+    for (size_t i = 0; i < collapsed.size(); i++)
+    {
+        const bool complete = collapsed[i].group == PackageGroups::kNoGroup ||
+                              static_cast<size_t>(collapsed[i].count) == groups.Members(collapsed[i].group).size();
+        if (complete && collapsed[i].weight <= max_carriable_weight)
+        {
+            order.push_back(i);
+        }
+    }
+    std::sort(order.begin(), order.end(),
+              [&collapsed](size_t lhs, size_t rhs)
+              {
+                  const groupItem &a = collapsed[lhs], &b = collapsed[rhs];
+                  return a.weight < b.weight || (a.weight == b.weight && (a.count < b.count || (a.count == b.count && a.idx < b.idx)));
+              });
+
+    ArenaVector<size_t> kept;
+    for (size_t first = 0, last = 0; first < order.size(); first = last)
+    {
+        const groupItem &head = collapsed[order[first]];
+        while (last < order.size() && collapsed[order[last]].weight == head.weight && collapsed[order[last]].count == head.count)
+        {
+            last++;
+        }
+        const size_t take = head.weight == 0 ? last - first : std::min<size_t>(last - first, max_carriable_weight / head.weight);
+        kept.insert(kept.end(), order.begin() + first, order.begin() + first + take);
+    }
+
+    // collapsed is laid out by first package, so are the kept items once sorted back.
+    std::sort(kept.begin(), kept.end());
+    SelectionItems relaxed;
+    for (auto &&i : kept)
+    {
+        relaxed.push_back(SelectionItem{collapsed[i].idx, static_cast<int>(collapsed[i].weight), 0, 0});
+    }
+
+    const int capacity = CompressCapacity(relaxed, max_carriable_weight);
+    scratch.scores.assign(capacity + 1, 0);
+    scratch.decisions.resize(relaxed.size(), capacity);
+    for (size_t i = 0; i < relaxed.size(); i++)
+    {
+        scratch.decisions.clear(i);
+        RelaxScores(scratch.scores.data(), scratch.decisions.row(i), capacity, relaxed[i].weight, collapsed[kept[i]].count);
+    }
+
+    bag.clear();
+    int remaining = capacity;
+    for (size_t i = relaxed.size(); i > 0; i--)
+    {
+        if (scratch.decisions.test(i - 1, remaining))
+        {
+            const size_t group = collapsed[kept[i - 1]].group;
+            if (group == PackageGroups::kNoGroup)
+            {
+                bag.push_back(relaxed[i - 1].idx);
+            }
+            else
+            {
+                bag.insert(bag.end(), groups.Members(group).begin(), groups.Members(group).end());
+            }
+            remaining -= relaxed[i - 1].weight;
+        }
+    }
+    std::sort(bag.begin(), bag.end(), std::greater<size_t>());
+}
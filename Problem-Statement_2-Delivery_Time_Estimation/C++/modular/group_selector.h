@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "selection.h"
+#include "shipment_selector.h"
+
+class Package;
+
+// Packages sharing a group id (a multi-box order) ship on one vehicle or not at all. An empty id is no group.
+class PackageGroups
+{
+    std::vector<size_t> group_of;
+    std::vector<std::vector<size_t>> members;
+
+public:
+    static const size_t kNoGroup;
+
+    explicit PackageGroups(std::vector<Package> &packages);
+
+    bool empty() const { return members.empty(); }
+
+    size_t GroupOf(size_t idx) const { return idx < group_of.size() ? group_of[idx] : kNoGroup; }
+
+    // The packages of a group, sorted by index.
+    const std::vector<size_t> &Members(size_t group) const { return members[group]; }
+};
+
+// Group knapsack on the waiting packages in items, sorted by index. Every group is collapsed into one kp item
+// weighing the whole group and counting each of its packages, placed at its first package, so a round relaxes
+// one item per group instead of one per package and no shipment can split a group. Items of the same weight and
+// count are interchangeable, so like WaitingPackages::Candidates only the first max_carriable_weight / weight of
+// them are relaxed. The bag is the one kp returns over these items, listed from the highest index down with every
+// package of a chosen group.
+void SelectGroups(const SelectionItems &items, const PackageGroups &groups, int max_carriable_weight,
+                  SelectionScratch &scratch, ArenaVector<size_t> &bag);
@@ -0,0 +1,282 @@
+#include "kp_kernel.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define KP_KERNEL_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(KP_KERNEL_X86) && (defined(__GNUC__) || defined(__clang__))
+#define KP_TARGET_AVX2 __attribute__((target("avx2")))
+#define KP_TARGET_SSE42 __attribute__((target("sse4.2")))
+#else
+#define KP_TARGET_AVX2
+#define KP_TARGET_SSE42
+#endif
+
+namespace
+{
+    using relax_fn = void (*)(uint64_t *, uint64_t *, int, int, int, uint64_t);
+    using relax_into_fn = void (*)(const uint64_t *, uint64_t *, uint64_t *, int, int, int, uint64_t);
+
+    inline void relaxCell(uint64_t *scores, uint64_t *decisions, int j, int weight, uint64_t item)
+    {
+        uint64_t candidate = scores[j - weight] + item;
+        if (candidate > scores[j])
+        {
+            scores[j] = candidate;
+            decisions[j >> 6] |= (uint64_t{1} << (j & 63));
+        }
+    }
+
+    // The in-place kernels walk j down from last to first, where first is at least weight.
+    void relaxScalar(uint64_t *scores, uint64_t *decisions, int first, int last, int weight, uint64_t item)
+    {
+        for (int j = last; j >= first; j--)
+        {
+            relaxCell(scores, decisions, j, weight, item);
+        }
+    }
+
+    inline void relaxCellInto(const uint64_t *previous, uint64_t *scores, uint64_t *decisions, int j, int weight, uint64_t item)
+    {
+        uint64_t candidate = previous[j - weight] + item;
+        if (candidate > previous[j])
+        {
+            scores[j] = candidate;
+            decisions[j >> 6] |= (uint64_t{1} << (j & 63));
+        }
+        else
+        {
+            scores[j] = previous[j];
+        }
+    }
+
+    // Copies the cells below weight and returns the first cell the item can reach.
+    inline int copyUnreachable(const uint64_t *previous, uint64_t *scores, int first, int last, int weight)
+    {
+        int j = first;
+        for (; j <= last && j < weight; j++)
+        {
+            scores[j] = previous[j];
+        }
+        return j;
+    }
+
+    void relaxIntoScalar(const uint64_t *previous, uint64_t *scores, uint64_t *decisions, int first, int last, int weight, uint64_t item)
+    {
+        for (int j = copyUnreachable(previous, scores, first, last, weight); j <= last; j++)
+        {
+            relaxCellInto(previous, scores, decisions, j, weight, item);
+        }
+    }
+
+#ifdef KP_KERNEL_X86
+    // Both vector kernels update the block [j - lanes + 1, j] from [j - weight - lanes + 1, j - weight].
+    // With weight >= lanes the source block lies entirely below the destination, so it still holds the
+    // previous package's scores, exactly as in the scalar downward sweep. Blocks are lane-aligned so the
+    // compare mask always lands inside a single decision word.
+    KP_TARGET_AVX2 void relaxAvx2(uint64_t *scores, uint64_t *decisions, int first, int last, int weight, uint64_t item)
+    {
+        int j = last;
+
+        if (weight >= 4)
+        {
+            for (; j >= first && ((j + 1) & 3) != 0; j--)
+            {
+                relaxCell(scores, decisions, j, weight, item);
+            }
+
+            const __m256i increment = _mm256_set1_epi64x(static_cast<long long>(item));
+            for (; j - 3 >= first; j -= 4)
+            {
+                int base = j - 3;
+                __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(scores + base));
+                __m256i candidate = _mm256_add_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(scores + base - weight)), increment);
+                __m256i improved = _mm256_cmpgt_epi64(candidate, current);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(scores + base), _mm256_blendv_epi8(current, candidate, improved));
+
+                uint64_t mask = static_cast<uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(improved)));
+                decisions[base >> 6] |= mask << (base & 63);
+            }
+        }
+
+        for (; j >= first; j--)
+        {
+            relaxCell(scores, decisions, j, weight, item);
+        }
+    }
+
+    KP_TARGET_SSE42 void relaxSse42(uint64_t *scores, uint64_t *decisions, int first, int last, int weight, uint64_t item)
+    {
+        int j = last;
+
+        if (weight >= 2)
+        {
+            for (; j >= first && ((j + 1) & 1) != 0; j--)
+            {
+                relaxCell(scores, decisions, j, weight, item);
+            }
+
+            const __m128i increment = _mm_set1_epi64x(static_cast<long long>(item));
+            for (; j - 1 >= first; j -= 2)
+            {
+                int base = j - 1;
+                __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i *>(scores + base));
+                __m128i candidate = _mm_add_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(scores + base - weight)), increment);
+                __m128i improved = _mm_cmpgt_epi64(candidate, current);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(scores + base), _mm_blendv_epi8(current, candidate, improved));
+
+                uint64_t mask = static_cast<uint64_t>(_mm_movemask_pd(_mm_castsi128_pd(improved)));
+                decisions[base >> 6] |= mask << (base & 63);
+            }
+        }
+
+        for (; j >= first; j--)
+        {
+            relaxCell(scores, decisions, j, weight, item);
+        }
+    }
+
+    KP_TARGET_AVX2 void relaxIntoAvx2(const uint64_t *previous, uint64_t *scores, uint64_t *decisions, int first, int last, int weight, uint64_t item)
+    {
+        int j = copyUnreachable(previous, scores, first, last, weight);
+
+        for (; j <= last && (j & 3) != 0; j++)
+        {
+            relaxCellInto(previous, scores, decisions, j, weight, item);
+        }
+
+        const __m256i increment = _mm256_set1_epi64x(static_cast<long long>(item));
+        for (; j + 3 <= last; j += 4)
+        {
+            __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(previous + j));
+            __m256i candidate = _mm256_add_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(previous + j - weight)), increment);
+            __m256i improved = _mm256_cmpgt_epi64(candidate, current);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(scores + j), _mm256_blendv_epi8(current, candidate, improved));
+
+            uint64_t mask = static_cast<uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(improved)));
+            decisions[j >> 6] |= mask << (j & 63);
+        }
+
+        for (; j <= last; j++)
+        {
+            relaxCellInto(previous, scores, decisions, j, weight, item);
+        }
+    }
+
+    KP_TARGET_SSE42 void relaxIntoSse42(const uint64_t *previous, uint64_t *scores, uint64_t *decisions, int first, int last, int weight, uint64_t item)
+    {
+        int j = copyUnreachable(previous, scores, first, last, weight);
+
+        for (; j <= last && (j & 1) != 0; j++)
+        {
+            relaxCellInto(previous, scores, decisions, j, weight, item);
+        }
+
+        const __m128i increment = _mm_set1_epi64x(static_cast<long long>(item));
+        for (; j + 1 <= last; j += 2)
+        {
+            __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i *>(previous + j));
+            __m128i candidate = _mm_add_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(previous + j - weight)), increment);
+            __m128i improved = _mm_cmpgt_epi64(candidate, current);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(scores + j), _mm_blendv_epi8(current, candidate, improved));
+
+            uint64_t mask = static_cast<uint64_t>(_mm_movemask_pd(_mm_castsi128_pd(improved)));
+            decisions[j >> 6] |= mask << (j & 63);
+        }
+
+        for (; j <= last; j++)
+        {
+            relaxCellInto(previous, scores, decisions, j, weight, item);
+        }
+    }
+
+    bool cpuHasAvx2()
+    {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0, avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+        {
+            return false;
+        }
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+
+    bool cpuHasSse42()
+    {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 1);
+        return (info[2] & (1 << 20)) != 0;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse4.2");
+#endif
+    }
+#endif
+
+    struct kernelChoice
+    {
+        relax_fn relax;
+        relax_into_fn relax_into;
+        const char *name;
+    };
+
+    const kernelChoice &activeKernel()
+    {
+        static const kernelChoice choice = []
+        {
+#ifdef KP_KERNEL_X86
+            if (cpuHasAvx2())
+            {
+                return kernelChoice{relaxAvx2, relaxIntoAvx2, "avx2"};
+            }
+            if (cpuHasSse42())
+            {
+                return kernelChoice{relaxSse42, relaxIntoSse42, "sse4.2"};
+            }
+#endif
+            return kernelChoice{relaxScalar, relaxIntoScalar, "scalar"};
+        }();
+        return choice;
+    }
+}
+
+void RelaxScores(uint64_t *scores, uint64_t *decisions, int capacity, int weight, int count)
+{
+    activeKernel().relax(scores, decisions, weight, capacity, weight, PackScore(count, weight));
+}
+
+void RelaxItemScores(uint64_t *scores, uint64_t *decisions, int capacity, int weight, uint64_t item)
+{
+    activeKernel().relax(scores, decisions, weight, capacity, weight, item);
+}
+
+void RelaxScoresRange(uint64_t *scores, uint64_t *decisions, int first, int last, int weight, int count)
+{
+    first = first > weight ? first : weight;
+    if (first <= last)
+    {
+        activeKernel().relax(scores, decisions, first, last, weight, PackScore(count, weight));
+    }
+}
+
+void RelaxScoresInto(const uint64_t *previous, uint64_t *scores, uint64_t *decisions, int first, int last, int weight, int count)
+{
+    activeKernel().relax_into(previous, scores, decisions, first, last, weight, PackScore(count, weight));
+}
+
+const char *KpKernelName()
+{
+    return activeKernel().name;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+// kp scores are packed as (count << 32) | weight, so a plain integer comparison of two scores
+// ranks them count first and weight as the tie-breaker, the order the kp selection maximises.
+inline uint64_t PackScore(int count, int weight)
+{
+    return (static_cast<uint64_t>(count) << 32) | static_cast<uint32_t>(weight);
+}
+
+inline int ScoreCount(uint64_t score) { return static_cast<int>(score >> 32); }
+inline int ScoreWeight(uint64_t score) { return static_cast<int>(score & 0xFFFFFFFFu); }
+
+// Relaxes scores[weight..capacity] with a single item of the given weight, i.e.
+// scores[j] = max(scores[j], scores[j - weight] + PackScore(count, weight)), walking j downwards.
+// An item is one package unless count says it bundles several (see weight_class_selector).
+// Bit j of decisions is set for every cell the item strictly improves, decisions must cover capacity + 1 bits.
+void RelaxScores(uint64_t *scores, uint64_t *decisions, int capacity, int weight, int count = 1);
+
+// Same, adding any item score instead of PackScore(count, weight), see objective_selector.h. Every score a row
+// reaches must stay below 2^63, the vector kernels compare them as signed integers.
+void RelaxItemScores(uint64_t *scores, uint64_t *decisions, int capacity, int weight, uint64_t item);
+
+// RelaxScores over the capacities [first, last] only, still in place and walking down. Cells below first are
+// read as they are, so they must not have been relaxed with this item yet.
+void RelaxScoresRange(uint64_t *scores, uint64_t *decisions, int first, int last, int weight, int count = 1);
+
+// Double-buffered RelaxScores over the capacities [first, last] only :
+// scores[j] = max(previous[j], previous[j - weight] + PackScore(count, weight)), or previous[j] when j < weight.
+// Nothing is read from scores, so disjoint ranges of one item can be relaxed by different threads as long as
+// each range starts on a multiple of 64 and never shares a decision word with another.
+void RelaxScoresInto(const uint64_t *previous, uint64_t *scores, uint64_t *decisions, int first, int last, int weight, int count = 1);
+
+// Name of the kernel picked by CPUID on first use ("avx2", "sse4.2" or "scalar").
+const char *KpKernelName();
@@ -0,0 +1,71 @@
+#include <algorithm>
+#include "kp_kernel.h"
+#include "tiled_kp.h"
+#include "linear_memory_selector.h"
+
+namespace
+{
+    struct linearMemorySweep
+    {
+        const SelectionItems &items;
+        const size_t decision_budget;
+        std::vector<uint64_t> decisions;
+        ArenaVector<size_t> &bag;
+
+        // Appends the bag of items [lo, hi) for the given capacity, where base[c] is the best score items [0, lo)
+        // reach within c, and returns the capacity left for items [0, lo).
+        int solve(size_t lo, size_t hi, const std::vector<uint64_t> &base, int capacity)
+        {
+            const size_t words_per_item = (static_cast<size_t>(capacity) >> 6) + 1;
+
+            if (DecisionBytes(hi - lo, capacity) <= decision_budget || hi - lo == 1)
+            {
+                std::vector<uint64_t> scores(base.begin(), base.begin() + capacity + 1);
+                decisions.assign((hi - lo) * words_per_item, 0);
+
+                if (capacity >= kTiledMinCapacity)
+                {
+                    SelectionItems leaf(items.begin() + lo, items.begin() + hi);
+                    TiledRelaxScores(leaf, capacity, scores.data(), decisions.data(), words_per_item, TiledBlockCells());
+                }
+                else
+                {
+                    for (size_t i = lo; i < hi; i++)
+                    {
+                        RelaxScores(scores.data(), decisions.data() + (i - lo) * words_per_item, capacity, items[i].weight);
+                    }
+                }
+
+                for (size_t i = hi; i > lo; i--)
+                {
+                    const uint64_t *row = decisions.data() + (i - 1 - lo) * words_per_item;
+                    if ((row[capacity >> 6] >> (capacity & 63)) & 1)
+                    {
+                        bag.push_back(items[i - 1].idx);
+                        capacity -= items[i - 1].weight;
+                    }
+                }
+                return capacity;
+            }
+
+            const size_t mid = lo + (hi - lo) / 2;
+            {
+                std::vector<uint64_t> middle(base.begin(), base.begin() + capacity + 1), unused(words_per_item);
+                for (size_t i = lo; i < mid; i++)
+                {
+                    RelaxScores(middle.data(), unused.data(), capacity, items[i].weight);
+                }
+                capacity = solve(mid, hi, middle, capacity);
+            }
+            return solve(lo, mid, base, capacity);
+        }
+    };
+}
+
+void SelectWithLinearMemory(const SelectionItems &items, int max_carriable_weight, size_t decision_budget,
+                            ArenaVector<size_t> &bag)
+{
+    bag.clear();
+    linearMemorySweep sweep{items, decision_budget, {}, bag};
+    sweep.solve(0, items.size(), std::vector<uint64_t>(max_carriable_weight + 1, 0), max_carriable_weight);
+}
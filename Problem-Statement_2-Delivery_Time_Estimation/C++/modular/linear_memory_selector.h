@@ -0,0 +1,19 @@
+#pragma once
+
+#include "selection.h"
+
+// kp for manifests whose decision bits, one per package and capacity, would not fit in decision_budget bytes.
+// The packages are halved recursively: the row of the lower half is swept without keeping any decisions, the
+// upper half is solved on top of it first, walking down from the capacity exactly as kp does, and the lower half
+// is then solved for the capacity the upper half left. A half whose decision bits fit in the budget is swept and
+// walked like kp. Every sweep only needs the capacities up to what is left at that point, so each level of the
+// recursion keeps one row of at most capacity + 1 scores, about log2(n (C + 1) / 8 / decision_budget) rows in all.
+// The packages are swept about that many times over, and the bag is the one kp returns.
+void SelectWithLinearMemory(const SelectionItems &items, int max_carriable_weight, size_t decision_budget,
+                            ArenaVector<size_t> &bag);
+
+// Bytes of decision bits kp needs for no_of_items packages and the given capacity.
+inline size_t DecisionBytes(size_t no_of_items, int max_carriable_weight)
+{
+    return no_of_items * ((static_cast<size_t>(max_carriable_weight) >> 6) + 1) * sizeof(uint64_t);
+}
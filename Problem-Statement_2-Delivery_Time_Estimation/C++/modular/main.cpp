@@ -1,9 +1,70 @@
 #include <iostream>
+#include <string>
+#include <cstdlib>
 #include "delivery_logic.h"
 
-int main()
+int main(int argc, char *argv[])
 {
+    SelectionOptions options;
+
+    // --shipment-cache N keeps up to N bags for re-plans of the same weights, see shipment_cache.h.
+    // --engine NAME forces one engine of Delivery::Selectors() (auto lets the cost model pick every round).
+    // --metrics writes the engine picked for every round to stderr.
+    // --objective NAME ships the most packages (count), the highest priority or the most revenue first.
+    // --pack-free-vehicles lets vehicles free at the same time ship the same weights, see SelectionOptions.
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string flag = argv[i];
+
+        if (flag == "--metrics")
+        {
+            options.metrics = &std::cerr;
+        }
+        else if (flag == "--pack-free-vehicles")
+        {
+            options.pack_free_vehicles = true;
+        }
+        else if (i + 1 == argc)
+        {
+            break;
+        }
+        else if (flag == "--shipment-cache")
+        {
+            long entries = std::strtol(argv[++i], nullptr, 10);
+            options.shipment_cache = entries > 0 ? static_cast<size_t>(entries) : 0;
+        }
+        else if (flag == "--objective")
+        {
+            const std::string name = argv[++i];
+            if (name == "priority")
+            {
+                options.objective = SelectionObjective::PriorityThenWeight;
+            }
+            else if (name == "revenue")
+            {
+                options.objective = SelectionObjective::RevenueThenWeight;
+            }
+            else if (name != "count")
+            {
+                std::cerr << "Unknown objective " << name << ", the most packages ship first" << '\n';
+            }
+        }
+        else if (flag == "--engine")
+        {
+            const std::string name = argv[++i];
+            const ShipmentSelector *selector = Delivery::Selectors().Find(name);
+            if (selector)
+            {
+                options.engine = selector->Engine();
+            }
+            else if (name != "auto")
+            {
+                std::cerr << "Unknown engine " << name << ", the cost model picks one every round" << '\n';
+            }
+        }
+    }
+
     Delivery::SetUpDelivery("json_files\\offers.json", false);
-    Delivery::ExecuteWorkflow();
+    Delivery::ExecuteWorkflow(std::cin, std::cout, options);
     Delivery::TearDownDelivery();
-}
\ No newline at end of file
+}
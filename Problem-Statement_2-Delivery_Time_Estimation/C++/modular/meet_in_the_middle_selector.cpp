@@ -0,0 +1,150 @@
+#include <algorithm>
+#include "meet_in_the_middle_selector.h"
+
+namespace
+{
+    struct halfSubset
+    {
+        int weight;
+        uint64_t mask;
+    };
+
+    // lists[k] holds the subsets of items[first, last) with k items that fit, sorted by weight. Items are merged
+    // in by increasing position, so on equal weight the subset already listed has the smaller mask and wins.
+    ArenaVector<ArenaVector<halfSubset>> listHalf(const SelectionItems &items, size_t first, size_t last, int max_carriable_weight)
+    {
+        ArenaVector<ArenaVector<halfSubset>> lists(1, ArenaVector<halfSubset>(1, halfSubset{0, 0}));
+        ArenaVector<halfSubset> merged;
+
+        for (size_t i = first; i < last; i++)
+        {
+            const int weight = items[i].weight;
+            const uint64_t bit = uint64_t{1} << i;
+            lists.emplace_back();
+
+            for (size_t k = lists.size() - 1; k > 0; k--)
+            {
+                const ArenaVector<halfSubset> &without = lists[k], &shorter = lists[k - 1];
+                merged.clear();
+
+                size_t a = 0, b = 0;
+                while (a < without.size() || b < shorter.size())
+                {
+                    bool shifted_fits = b < shorter.size() && shorter[b].weight <= max_carriable_weight - weight;
+                    if (!shifted_fits && a == without.size())
+                    {
+                        break;
+                    }
+
+                    halfSubset next{0, 0};
+                    if (!shifted_fits || (a < without.size() && without[a].weight <= shorter[b].weight + weight))
+                    {
+                        next = without[a++];
+                    }
+                    else
+                    {
+                        next = halfSubset{shorter[b].weight + weight, shorter[b].mask | bit};
+                        b++;
+                    }
+
+                    if (merged.empty() || merged.back().weight != next.weight)
+                    {
+                        merged.push_back(next);
+                    }
+                }
+                lists[k].swap(merged);
+            }
+
+            if (lists.back().empty())
+            {
+                lists.pop_back();
+            }
+        }
+        return lists;
+    }
+
+    const halfSubset *findWeight(const ArenaVector<halfSubset> &list, int weight)
+    {
+        auto found = std::lower_bound(list.begin(), list.end(), weight,
+                                      [](const halfSubset &subset, int value)
+                                      {
+                                          return subset.weight < value;
+                                      });
+        return found != list.end() && found->weight == weight ? &*found : nullptr;
+    }
+}
+
+bool SelectMeetInTheMiddle(const SelectionItems &items, int max_carriable_weight, ArenaVector<size_t> &bag)
+{
+    if (items.size() > kMeetInTheMiddleMaxItems)
+    {
+        return false;
+    }
+
+    const size_t half = items.size() / 2;
+    auto low = listHalf(items, 0, half, max_carriable_weight);
+    auto high = listHalf(items, half, items.size(), max_carriable_weight);
+
+    const size_t max_count = static_cast<size_t>(MaxShipmentCount(items, max_carriable_weight));
+    int best_weight = -1;
+
+    for (size_t k = 0; k < high.size() && k <= max_count; k++)
+    {
+        if (max_count - k >= low.size())
+        {
+            continue;
+        }
+
+        // Heavier high-half subsets leave less room, so the low-half pointer only moves down.
+        const ArenaVector<halfSubset> &partners = low[max_count - k];
+        size_t partner = partners.size();
+
+        for (auto &&subset : high[k])
+        {
+            while (partner > 0 && partners[partner - 1].weight > max_carriable_weight - subset.weight)
+            {
+                partner--;
+            }
+            if (partner == 0)
+            {
+                break;
+            }
+            best_weight = std::max(best_weight, subset.weight + partners[partner - 1].weight);
+        }
+    }
+
+    uint64_t best_mask = 0;
+    bool found = false;
+
+    for (size_t k = 0; k < high.size() && k <= max_count; k++)
+    {
+        if (max_count - k >= low.size())
+        {
+            continue;
+        }
+
+        for (auto &&subset : high[k])
+        {
+            if (subset.weight > best_weight || (found && subset.mask >= best_mask))
+            {
+                continue;
+            }
+
+            const halfSubset *partner = findWeight(low[max_count - k], best_weight - subset.weight);
+            if (partner != nullptr && (!found || (subset.mask | partner->mask) < best_mask))
+            {
+                best_mask = subset.mask | partner->mask;
+                found = true;
+            }
+        }
+    }
+
+    bag.clear();
+    while (best_mask != 0)
+    {
+        int position = HighestSetBit(best_mask);
+        bag.push_back(items[position].idx);
+        best_mask &= ~(uint64_t{1} << position);
+    }
+    return true;
+}
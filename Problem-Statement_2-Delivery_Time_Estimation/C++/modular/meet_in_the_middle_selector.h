@@ -0,0 +1,38 @@
+#pragma once
+
+#include <algorithm>
+#include "selection.h"
+
+const size_t kMeetInTheMiddleMaxItems = 40;
+
+// Exact selector for short manifests with capacities of any size (weights in grams). The items are split into a
+// low half and a high half by index, and every subset of each half that fits is listed per package count,
+// sorted by weight with only the lowest-index subset kept per (count, weight). The best weight for the
+// maximal count k* is then found by pairing each high-half list with the low-half list for the remaining count.
+// Reading the chosen subset as a bit mask over the item positions, kp's bag is the smallest mask with that
+// score, so the smallest high-half mask with a matching low half is picked first and then its low half.
+//
+// Returns false, leaving bag untouched, when there are more than kMeetInTheMiddleMaxItems items.
+bool SelectMeetInTheMiddle(const SelectionItems &items, int max_carriable_weight, ArenaVector<size_t> &bag);
+
+// Worst case cost of SelectMeetInTheMiddle, in dense cell updates : each half lists its subsets of up to
+// max_count packages, the most a fitting subset can hold, and a listed subset costs roughly 16 cells.
+inline long long MeetInTheMiddleWork(size_t no_of_items, size_t max_count)
+{
+    if (no_of_items > kMeetInTheMiddleMaxItems)
+    {
+        return -1;
+    }
+
+    long long work = 0;
+    for (size_t half : {no_of_items / 2, no_of_items - no_of_items / 2})
+    {
+        long long subsets = 1;
+        for (size_t j = 0; j <= std::min(half, max_count); j++)
+        {
+            work += 16 * subsets;
+            subsets = subsets * (half - j) / (j + 1);
+        }
+    }
+    return work;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "selection.h"
+#include "shipment_selector.h"
+#include "kp_kernel.h"
+
+// What a shipment maximises, as a policy type : the score of one package, added up over a shipment and compared as
+// an unsigned integer. SelectByObjective is instantiated per policy, so the policy is known at compile time and
+// called once per package to give the constant the kp kernel adds across the row, never per cell.
+
+// The objective of Delivery::kp and every engine of shipment_selector.h : most packages, then most weight.
+struct CountThenWeight
+{
+    uint64_t operator()(const SelectionItem &item) const { return PackScore(1, item.weight); }
+};
+
+// Highest total priority, then most weight. priorities[idx] is Package::getPriority of package idx, 1 by default,
+// so a plan where nobody raised a priority ships like CountThenWeight and an express parcel of priority 2 takes
+// a slot before a standard one.
+struct PriorityThenWeight
+{
+    const int *priorities;
+
+    uint64_t operator()(const SelectionItem &item) const { return PackScore(priorities[item.idx], item.weight); }
+};
+
+// Most revenue, then most weight. cents[idx] is Package::getCost of package idx in cents.
+struct RevenueThenWeight
+{
+    const int *cents;
+
+    uint64_t operator()(const SelectionItem &item) const { return PackScore(cents[item.idx], item.weight); }
+};
+
+// Per package scores for PriorityThenWeight and RevenueThenWeight from values of 0..INT32_MAX. The SIMD kernels
+// compare scores as signed integers, so when the values add up to 2^31 or more every one is divided by the same
+// factor, rounding down, until no shipment can reach 2^31. A package then never outscores one of a higher value.
+inline std::vector<int> ObjectiveScores(const std::vector<long long> &values)
+{
+    const long long limit = std::numeric_limits<int32_t>::max();
+    long long total = 0;
+    for (auto &&value : values)
+    {
+        total += value;
+    }
+    const long long divisor = total > limit ? (total + limit - 1) / limit : 1;
+
+    std::vector<int> scores;
+    scores.reserve(values.size());
+    for (auto &&value : values)
+    {
+        scores.push_back(static_cast<int>(value / divisor));
+    }
+    return scores;
+}
+
+// Dense kp maximising the objective over items, sorted by index. The totals of the upper halves must stay below
+// 2^31, which ObjectiveScores ensures. Among the best shipments the bag is picked like Delivery::kp, walking the
+// items from the last one down, and it is listed from the highest index down. Packages scoring nothing still ship
+// when they add weight, like any other tie.
+template <class Objective>
+void SelectByObjective(const SelectionItems &items, int max_carriable_weight, const Objective &objective,
+                       SelectionScratch &scratch, ArenaVector<size_t> &bag)
+{
+    SelectionItems compressed(items.begin(), items.end());
+    const int capacity = CompressCapacity(compressed, max_carriable_weight);
+
+    scratch.scores.assign(capacity + 1, 0);
+    scratch.decisions.resize(compressed.size(), capacity);
+    for (size_t i = 0; i < compressed.size(); i++)
+    {
+        scratch.decisions.clear(i);
+        RelaxItemScores(scratch.scores.data(), scratch.decisions.row(i), capacity, compressed[i].weight, objective(items[i]));
+    }
+
+    bag.clear();
+    int remaining = capacity;
+    for (size_t i = compressed.size(); i > 0; i--)
+    {
+        if (scratch.decisions.test(i - 1, remaining))
+        {
+            bag.push_back(compressed[i - 1].idx);
+            remaining -= compressed[i - 1].weight;
+        }
+    }
+}
@@ -10,6 +10,9 @@ class Package
     std::string id;
     int weight = 0;
     int distance = 0;
+    int volume = 0;
+    std::string group_id;
+    int priority = 1;
     double discount = 0.0f;
     double cost = 0.0f;
     float delivery_time = 0.0f;
@@ -25,9 +28,17 @@ public:
 
     int getWeight() { return weight; }
     int getDistance() { return distance; }
+    int getVolume() { return volume; }
+    std::string getGroupId() { return group_id; }
+    int getPriority() { return priority; }
+    double getCost() { return cost; }
     float getDeliveryTime() { return delivery_time; }
 
     void setDeliveryTime(float dt)  { delivery_time = dt; }
+    // A negative volume is rejected, the package keeps the one it had.
+    void setVolume(int vol) { volume = vol >= 0 ? vol : volume; }
+    void setGroupId(std::string group) { group_id = std::move(group); }
+    void setPriority(int prio) { priority = prio; }
 
     friend std::ostream& operator <<(std::ostream& os, const Package& pkg);
 };
\ No newline at end of file
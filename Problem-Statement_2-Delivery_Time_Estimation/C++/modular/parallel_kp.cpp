@@ -0,0 +1,50 @@
+#include <algorithm>
+#include "kp_kernel.h"
+#include "thread_pool.h"
+#include "parallel_kp.h"
+
+size_t ParallelSweepThreads(int capacity, unsigned no_of_threads)
+{
+    size_t useful = static_cast<size_t>(capacity + 1) / kParallelMinCellsPerThread;
+    return std::max<size_t>(1, std::min<size_t>(no_of_threads, useful));
+}
+
+void ParallelRelaxScores(const SelectionItems &items, int capacity, std::vector<uint64_t> &scores,
+                         std::vector<uint64_t> &spare, uint64_t *decisions, size_t words_per_item, size_t no_of_threads)
+{
+    ThreadPool &pool = SharedThreadPool(no_of_threads);
+    SpinBarrier barrier(pool.size());
+    spare.resize(scores.size());
+
+    const size_t no_of_words = (static_cast<size_t>(capacity) >> 6) + 1;
+
+    pool.Run([&](size_t thread_id)
+             {
+                 const size_t first_word = no_of_words * thread_id / pool.size();
+                 const size_t last_word = no_of_words * (thread_id + 1) / pool.size();
+                 const int first = static_cast<int>(first_word << 6);
+                 const int last = std::min(capacity, static_cast<int>(last_word << 6) - 1);
+
+                 uint64_t *previous = scores.data();
+                 uint64_t *next = spare.data();
+
+                 for (size_t i = 0; i < items.size(); i++)
+                 {
+                     uint64_t *row = decisions + i * words_per_item;
+                     std::fill(row + first_word, row + last_word, 0);
+
+                     if (first <= last)
+                     {
+                         RelaxScoresInto(previous, next, row, first, last, items[i].weight);
+                     }
+                     barrier.Wait();
+
+                     std::swap(previous, next);
+                 }
+             });
+
+    if (items.size() % 2 == 1)
+    {
+        scores.swap(spare);
+    }
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "selection.h"
+
+// Capacities each thread should own before splitting a kp sweep pays for the barrier after every package.
+const int kParallelMinCellsPerThread = 1 << 14;
+
+// Threads worth using for a sweep over capacity + 1 cells, at most no_of_threads.
+size_t ParallelSweepThreads(int capacity, unsigned no_of_threads);
+
+// The kp sweep with each package's capacities split across the shared pool. Every thread owns a range of
+// capacities starting on a decision word, reads the previous package's row and writes the next one (rows
+// alternate between scores and a second buffer), and all threads meet at a barrier before the next package.
+// scores and the decision rows end up exactly as the serial sweep leaves them, whatever the thread count.
+// spare is the second buffer, kept by the caller so a plan sizes it once. Its contents are overwritten.
+void ParallelRelaxScores(const SelectionItems &items, int capacity, std::vector<uint64_t> &scores,
+                         std::vector<uint64_t> &spare, uint64_t *decisions, size_t words_per_item, size_t no_of_threads);
@@ -0,0 +1,63 @@
+#include <algorithm>
+#include <cstdint>
+#include "planning_arena.h"
+
+thread_local PlanningArena *PlanningArena::current = nullptr;
+
+PlanningArena::~PlanningArena()
+{
+    for (auto &&taken : blocks)
+    {
+        ::operator delete(taken.data);
+    }
+}
+
+void *PlanningArena::Allocate(size_t bytes, size_t alignment)
+{
+    allocations++;
+
+    auto aligned = [alignment](char *p)
+    {
+        return reinterpret_cast<char *>((reinterpret_cast<uintptr_t>(p) + alignment - 1) & ~(uintptr_t{alignment} - 1));
+    };
+
+    char *start = cursor == nullptr ? nullptr : aligned(cursor);
+    if (start == nullptr || bytes > static_cast<size_t>(end - start))
+    {
+        const size_t size = std::max(next_block_size, bytes + alignment);
+        blocks.push_back(block{static_cast<char *>(::operator new(size)), size});
+        upstream_allocations++;
+        next_block_size = size * 2;
+
+        cursor = blocks.back().data;
+        end = cursor + size;
+        start = aligned(cursor);
+    }
+
+    cursor = start + bytes;
+    return start;
+}
+
+void PlanningArena::Release()
+{
+    if (blocks.empty())
+    {
+        return;
+    }
+
+    auto largest = std::max_element(blocks.begin(), blocks.end(),
+                                    [](const block &lhs, const block &rhs)
+                                    {
+                                        return lhs.size < rhs.size;
+                                    });
+    std::swap(*largest, blocks.front());
+
+    for (size_t i = 1; i < blocks.size(); i++)
+    {
+        ::operator delete(blocks[i].data);
+    }
+    blocks.resize(1);
+
+    cursor = blocks.front().data;
+    end = cursor + blocks.front().size;
+}
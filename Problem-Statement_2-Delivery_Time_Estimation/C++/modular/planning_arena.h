@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// Monotonic arena for the short-lived containers of one planning call, the C++14 stand-in for
+// std::pmr::monotonic_buffer_resource. Allocating bumps a pointer through blocks taken from the global heap,
+// deallocating does nothing, and Release() drops everything at once while keeping the largest block, so a
+// planner that releases after every round stops touching the global heap (and its lock) once warmed up.
+class PlanningArena
+{
+    struct block
+    {
+        char *data;
+        size_t size;
+    };
+
+    std::vector<block> blocks;
+    char *cursor = nullptr, *end = nullptr;
+    size_t next_block_size;
+    size_t allocations = 0, upstream_allocations = 0;
+
+    static thread_local PlanningArena *current;
+
+public:
+    explicit PlanningArena(size_t initial_block_size = size_t{64} << 10) : next_block_size(initial_block_size) {}
+    ~PlanningArena();
+
+    PlanningArena(const PlanningArena &) = delete;
+    PlanningArena &operator=(const PlanningArena &) = delete;
+
+    void *Allocate(size_t bytes, size_t alignment);
+    void Release();
+
+    // Requests served by the arena, and blocks it had to take from the global heap for them.
+    size_t Allocations() const { return allocations; }
+    size_t UpstreamAllocations() const { return upstream_allocations; }
+
+    // Arena that containers built on this thread draw from, the pmr default resource of this scheme.
+    // nullptr means the global heap.
+    static PlanningArena *Current() { return current; }
+
+    // Makes an arena (or the global heap, for nullptr) current on this thread until the scope ends.
+    class Scope
+    {
+        PlanningArena *previous;
+
+    public:
+        explicit Scope(PlanningArena *arena) : previous(current) { current = arena; }
+        ~Scope() { current = previous; }
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+    };
+};
+
+// Allocator bound to the arena current when it was constructed, like std::pmr::polymorphic_allocator.
+// A container keeps its arena for life, so it must not outlive the arena's next Release(). Copies take the
+// arena current where they are made rather than the source's, so a round never copies onto the plan arena.
+template <class T>
+class ArenaAllocator
+{
+    template <class U>
+    friend class ArenaAllocator;
+
+    PlanningArena *arena;
+
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ArenaAllocator() : arena(PlanningArena::Current()) {}
+
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U> &other) : arena(other.arena) {}
+
+    ArenaAllocator select_on_container_copy_construction() const { return ArenaAllocator(); }
+
+    T *allocate(size_t n)
+    {
+        if (arena == nullptr)
+        {
+            return static_cast<T *>(::operator new(n * sizeof(T)));
+        }
+        return static_cast<T *>(arena->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *p, size_t)
+    {
+        if (arena == nullptr)
+        {
+            ::operator delete(p);
+        }
+    }
+
+    template <class U>
+    bool operator==(const ArenaAllocator<U> &other) const { return arena == other.arena; }
+
+    template <class U>
+    bool operator!=(const ArenaAllocator<U> &other) const { return arena != other.arena; }
+};
+
+template <class T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include "selection.h"
+
+ArenaVector<long long> LightestWeightSums(const SelectionItems &items)
+{
+    ArenaVector<int> weights;
+    weights.reserve(items.size());
+
+    for (auto &&item : items)
+    {
+        weights.push_back(item.weight);
+    }
+    std::sort(weights.begin(), weights.end());
+
+    ArenaVector<long long> sums(weights.size() + 1, 0);
+    for (size_t k = 0; k < weights.size(); k++)
+    {
+        sums[k + 1] = sums[k] + weights[k];
+    }
+    return sums;
+}
+
+int MaxShipmentCount(const ArenaVector<long long> &lightest_sums, int max_carriable_weight)
+{
+    auto beyond = std::upper_bound(lightest_sums.begin(), lightest_sums.end(), static_cast<long long>(max_carriable_weight));
+    return static_cast<int>(beyond - lightest_sums.begin()) - 1;
+}
+
+int MaxShipmentCount(const SelectionItems &items, int max_carriable_weight)
+{
+    return MaxShipmentCount(LightestWeightSums(items), max_carriable_weight);
+}
+
+int CompressCapacity(SelectionItems &items, int max_carriable_weight)
+{
+    int divisor = 0;
+    return CompressCapacity(items, max_carriable_weight, divisor);
+}
+
+int CompressCapacity(SelectionItems &items, int max_carriable_weight, int &divisor)
+{
+    divisor = 0;
+    long long total = 0;
+
+    for (auto &&item : items)
+    {
+        int a = divisor, b = item.weight;
+        while (b != 0)
+        {
+            int r = a % b;
+            a = b;
+            b = r;
+        }
+        divisor = a;
+        total += item.weight;
+    }
+
+    if (divisor <= 1)
+    {
+        divisor = 1;
+        return static_cast<int>(std::min<long long>(max_carriable_weight, total));
+    }
+
+    for (auto &&item : items)
+    {
+        item.weight /= divisor;
+    }
+    return static_cast<int>(std::min<long long>(max_carriable_weight / divisor, total / divisor));
+}
+
+int RoundWeightsUp(SelectionItems &items, int max_carriable_weight, int granularity)
+{
+    for (auto &&item : items)
+    {
+        item.weight = item.weight / granularity + (item.weight % granularity != 0 ? 1 : 0);
+    }
+    return max_carriable_weight / granularity;
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <vector>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include "planning_arena.h"
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// A package that can still be shipped in the current round : its index into the packages vector, its weight, its
+// distance (only used by engines that prefer nearer packages on a tie) and its volume (only used under a
+// VehicleLimits volume limit).
+struct SelectionItem
+{
+    size_t idx;
+    int weight;
+    int distance;
+    int volume;
+};
+
+using SelectionItems = ArenaVector<SelectionItem>;
+
+// Every selection engine returns the same bag as Delivery::kp : among all subsets with the most packages and,
+// within those, the most weight not exceeding the capacity, the one found by walking the items from the last
+// one down and skipping an item whenever the items before it can still reach the remaining (count, weight).
+// Package indices are listed from the highest index down.
+enum class SelectionEngine
+{
+    Auto,
+    DenseDP,
+    Bitset,
+    CountFirst,
+    WeightClasses,
+    Sparse,
+    MeetInTheMiddle,
+    BranchAndBound,
+    Approximate
+};
+
+// WeightClasses prefers nearer packages, BranchAndBound may stop at its time budget and Approximate gives up some
+// weight, every other engine returns exactly the bag of Delivery::kp.
+inline bool ReturnsKpBag(SelectionEngine engine)
+{
+    return engine != SelectionEngine::WeightClasses && engine != SelectionEngine::BranchAndBound &&
+           engine != SelectionEngine::Approximate;
+}
+
+// What a shipment maximises, see objective_selector.h. Only CountThenWeight is understood by every engine, the
+// others are solved by a dense kp of their own.
+enum class SelectionObjective
+{
+    CountThenWeight,
+    PriorityThenWeight,
+    RevenueThenWeight
+};
+
+// What a vehicle can take besides max_carriable_weight : the total volume of its load and the number of parcels,
+// 0 leaving a limit off. Any limit set is handled by SelectWithVehicleLimits (two_constraint_selector.h).
+struct VehicleLimits
+{
+    int max_volume = 0;
+    int max_parcels = 0;
+
+    bool Any() const { return max_volume > 0 || max_parcels > 0; }
+};
+
+struct SelectionOptions
+{
+    SelectionEngine engine = SelectionEngine::Auto;
+    // Rounds of vehicles without limits in plans without groups maximise this objective.
+    SelectionObjective objective = SelectionObjective::CountThenWeight;
+    // Wall-clock limit per shipment for SelectionEngine::BranchAndBound, unlimited by default.
+    std::chrono::microseconds time_budget = std::chrono::microseconds::max();
+    // Weight SelectionEngine::Approximate may give up against the best shipment, as a fraction of it.
+    double epsilon = 0.01;
+    // Threads the dense kp sweep may split each package's capacities across, see parallel_kp.h.
+    unsigned threads = 1;
+    // Lets a single-threaded kp sweep over a row wider than L2 relax several packages per pass, see tiled_kp.h.
+    bool tiled_sweep = true;
+    // Bytes of decision bits kp may keep. Larger manifests are solved in linear memory (linear_memory_selector.h),
+    // by default half of the 512 MB a planner container gets.
+    size_t decision_budget = size_t{256} << 20;
+    // Builds the per-round containers of a plan in a PlanningArena released after every round, see planning_arena.h.
+    bool planning_arena = true;
+    // Lets kp use the compile-time row of fixed_capacity_selector.h when the capacity is a standard vehicle class.
+    bool fixed_capacities = true;
+    // Lets Delivery_Time ship a trivial round without any engine, see WaitingPackages::TrivialShipment.
+    bool trivial_rounds = true;
+    // Lets a vehicle free at the same time as the last one, and as large, ship the same weights again without a solve,
+    // see WaitingPackages::RepeatShipment. Every such vehicle still ships a best shipment, but not always the
+    // packages kp would pick among the best ones.
+    bool pack_free_vehicles = false;
+    // Bags kept by the process-wide ShipmentCache (shipment_cache.h) for engines returning the kp bag, 0 is off.
+    size_t shipment_cache = 0;
+    // Receives one line per round of Delivery_Time : the engine that picked the shipment and its estimated cost.
+    std::ostream *metrics = nullptr;
+};
+
+// Divides every item weight by their greatest common divisor and returns the capacity in those units, clamped
+// to the total weight of the items since no shipment can use more. A bag found on the compressed items is the
+// bag the original weights would give, while dense engines only need a row that many cells wide.
+int CompressCapacity(SelectionItems &items, int max_carriable_weight);
+
+// Same, also giving the divisor, so that other capacities can be brought to the same units.
+int CompressCapacity(SelectionItems &items, int max_carriable_weight, int &divisor);
+
+// Rounds every item weight up to the next multiple of granularity, expressed in multiples, and returns the
+// capacity in the same units rounded down. A bag that fits the rounded capacity also fits the real one.
+int RoundWeightsUp(SelectionItems &items, int max_carriable_weight, int granularity);
+
+// sums[k] is the total weight of the k lightest items, the least any k-package shipment can weigh.
+ArenaVector<long long> LightestWeightSums(const SelectionItems &items);
+
+// Largest number of items that fit together, found by taking the lightest ones first.
+int MaxShipmentCount(const ArenaVector<long long> &lightest_sums, int max_carriable_weight);
+int MaxShipmentCount(const SelectionItems &items, int max_carriable_weight);
+
+inline int CountTrailingZeros(uint64_t word)
+{
+#ifdef _MSC_VER
+    unsigned long idx;
+    _BitScanForward64(&idx, word);
+    return static_cast<int>(idx);
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+inline int HighestSetBit(uint64_t word)
+{
+#ifdef _MSC_VER
+    unsigned long idx;
+    _BitScanReverse64(&idx, word);
+    return static_cast<int>(idx);
+#else
+    return 63 - __builtin_clzll(word);
+#endif
+}
@@ -0,0 +1,159 @@
+#include <algorithm>
+#include "shipment_cache.h"
+
+namespace
+{
+    // FNV-1a over the capacity and the weights.
+    uint64_t shipmentKey(int max_carriable_weight, const SelectionItems &items)
+    {
+        uint64_t key = 14695981039346656037ull;
+        const auto mix = [&key](uint64_t value)
+        {
+            key = (key ^ value) * 1099511628211ull;
+        };
+
+        mix(static_cast<uint32_t>(max_carriable_weight));
+        for (auto &&item : items)
+        {
+            mix(static_cast<uint32_t>(item.weight));
+        }
+        return key;
+    }
+
+    bool sameWeights(const std::vector<int> &weights, const SelectionItems &items)
+    {
+        return weights.size() == items.size() &&
+               std::equal(weights.begin(), weights.end(), items.begin(),
+                          [](int weight, const SelectionItem &item)
+                          {
+                              return weight == item.weight;
+                          });
+    }
+}
+
+void ShipmentCache::evict(size_t keep)
+{
+    while (entries.size() > keep)
+    {
+        index.erase(entries.back().key);
+        entries.pop_back();
+        evictions++;
+    }
+}
+
+bool ShipmentCache::Find(int max_carriable_weight, const SelectionItems &items, ArenaVector<size_t> &bag)
+{
+    const uint64_t key = shipmentKey(max_carriable_weight, items);
+    std::lock_guard<std::mutex> guard(lock);
+
+    auto found = index.find(key);
+    if (found == index.end() || found->second->capacity != max_carriable_weight || !sameWeights(found->second->weights, items))
+    {
+        misses++;
+        return false;
+    }
+
+    entries.splice(entries.begin(), entries, found->second);
+    bag.clear();
+    for (auto &&position : found->second->positions)
+    {
+        bag.push_back(items[position].idx);
+    }
+    hits++;
+    return true;
+}
+
+void ShipmentCache::Insert(int max_carriable_weight, const SelectionItems &items, const ArenaVector<size_t> &bag)
+{
+    // The items are sorted by index, so every package of the bag is found by a binary search.
+    std::vector<size_t> positions;
+    positions.reserve(bag.size());
+    for (auto &&idx : bag)
+    {
+        auto item = std::lower_bound(items.begin(), items.end(), idx,
+                                     [](const SelectionItem &candidate, size_t value)
+                                     {
+                                         return candidate.idx < value;
+                                     });
+        positions.push_back(item - items.begin());
+    }
+
+    std::vector<int> weights;
+    weights.reserve(items.size());
+    for (auto &&item : items)
+    {
+        weights.push_back(item.weight);
+    }
+
+    const uint64_t key = shipmentKey(max_carriable_weight, items);
+    std::lock_guard<std::mutex> guard(lock);
+    if (max_entries == 0)
+    {
+        return;
+    }
+
+    // A colliding key just hands its slot over to the newer bag.
+    auto found = index.find(key);
+    if (found != index.end())
+    {
+        entries.erase(found->second);
+        index.erase(found);
+    }
+
+    entries.push_front(entry{key, max_carriable_weight, std::move(weights), std::move(positions)});
+    index[key] = entries.begin();
+    evict(max_entries);
+}
+
+void ShipmentCache::Resize(size_t max_entries)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    this->max_entries = max_entries;
+    evict(max_entries);
+}
+
+void ShipmentCache::Grow(size_t max_entries)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    this->max_entries = std::max(this->max_entries, max_entries);
+}
+
+void ShipmentCache::Clear()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    entries.clear();
+    index.clear();
+    hits = misses = evictions = 0;
+}
+
+size_t ShipmentCache::size() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return entries.size();
+}
+
+size_t ShipmentCache::Hits() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return hits;
+}
+
+size_t ShipmentCache::Misses() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return misses;
+}
+
+size_t ShipmentCache::Evictions() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return evictions;
+}
+
+ShipmentCache &SharedShipmentCache(size_t max_entries)
+{
+    static ShipmentCache cache(max_entries);
+
+    cache.Grow(max_entries);
+    return cache;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "selection.h"
+
+// Bounded LRU memo of kp bags shared by every plan in the process, for dispatchers that keep re-planning the same
+// manifests. The bag kp picks only depends on the capacity and the candidate weights in index order, so that is
+// the key, and the bag is kept as positions into the candidates : any later round offering the same weights in the
+// same order, whichever packages carry them, gets its bag back without running an engine.
+class ShipmentCache
+{
+    struct entry
+    {
+        uint64_t key;
+        int capacity;
+        std::vector<int> weights;
+        std::vector<size_t> positions;
+    };
+
+    std::list<entry> entries;
+    std::unordered_map<uint64_t, std::list<entry>::iterator> index;
+    size_t max_entries;
+    size_t hits = 0, misses = 0, evictions = 0;
+    mutable std::mutex lock;
+
+    void evict(size_t keep);
+
+public:
+    explicit ShipmentCache(size_t max_entries) : max_entries(max_entries) {}
+
+    ShipmentCache(const ShipmentCache &) = delete;
+    ShipmentCache &operator=(const ShipmentCache &) = delete;
+
+    // Fills bag with the packages of items kp picks for this capacity, when that bag is cached.
+    bool Find(int max_carriable_weight, const SelectionItems &items, ArenaVector<size_t> &bag);
+
+    // Remembers the bag picked from items, dropping the least recently used bag once full.
+    void Insert(int max_carriable_weight, const SelectionItems &items, const ArenaVector<size_t> &bag);
+
+    // Keeps at most max_entries bags, 0 turns the cache off.
+    void Resize(size_t max_entries);
+    // Raises the bound to max_entries when it is lower, never dropping a bag.
+    void Grow(size_t max_entries);
+    void Clear();
+
+    size_t size() const;
+    size_t Hits() const;
+    size_t Misses() const;
+    size_t Evictions() const;
+};
+
+// Cache shared by every plan, holding up to the largest max_entries any plan has asked for, so a plan asking for
+// fewer bags never evicts those of another.
+ShipmentCache &SharedShipmentCache(size_t max_entries);
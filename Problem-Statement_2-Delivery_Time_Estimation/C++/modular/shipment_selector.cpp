@@ -0,0 +1,354 @@
+#include <cmath>
+#include <limits>
+#include "shipment_selector.h"
+#include "bitset_selector.h"
+#include "count_first_selector.h"
+#include "weight_class_selector.h"
+#include "sparse_selector.h"
+#include "meet_in_the_middle_selector.h"
+#include "branch_and_bound_selector.h"
+
+namespace
+{
+    const double kUnbounded = std::numeric_limits<double>::infinity();
+
+    long long workLimit(double work_limit)
+    {
+        return work_limit >= static_cast<double>(std::numeric_limits<long long>::max()) ? std::numeric_limits<long long>::max()
+                                                                                        : static_cast<long long>(work_limit);
+    }
+
+    double cells(const SelectionProfile &profile)
+    {
+        return static_cast<double>(profile.capacity) + 1;
+    }
+
+    class bitsetSelector : public ShipmentSelector
+    {
+    public:
+        SelectionEngine Engine() const override { return SelectionEngine::Bitset; }
+        const char *Name() const override { return "bitset"; }
+
+        // Every package ORs the window of each level, 64 capacities a word, and a first-reach cell is cleared per
+        // level and capacity up front. Measured, a word costs about two dense cells, a visited level eight and a
+        // cleared first-reach cell one and a half.
+        SelectionCost EstimateCost(const SelectionProfile &profile, const SelectionOptions &) const override
+        {
+            const double levels = profile.max_count + 1.0;
+            return SelectionCost{profile.items * (2 * profile.count_window_cells / 64 + 8 * levels) +
+                                     1.5 * levels * cells(profile),
+                                 levels * cells(profile) * (sizeof(int) + 1.0 / 8)};
+        }
+
+        bool Select(SelectionItems &items, int capacity, const SelectionOptions &, double, SelectionScratch &,
+                    ArenaVector<size_t> &bag) const override
+        {
+            bag = SelectByBitsets(items, capacity);
+            return true;
+        }
+    };
+
+    class countFirstSelector : public ShipmentSelector
+    {
+    public:
+        SelectionEngine Engine() const override { return SelectionEngine::CountFirst; }
+        const char *Name() const override { return "count-first"; }
+
+        // The (balance, gain) window SelectCountFirst checks against its work limit, plus sorting and splitting the
+        // packages, which measures at some 24 cells a package on top of the sort.
+        SelectionCost EstimateCost(const SelectionProfile &profile, const SelectionOptions &) const override
+        {
+            const double window = profile.swap_span == 0 ? 0 : (2.0 * profile.swap_span + 1) * (profile.slack + 1.0);
+            return SelectionCost{profile.items * (std::log2(profile.items + 2.0) + 24) +
+                                     profile.swap_candidates * window,
+                                 window * sizeof(int)};
+        }
+
+        bool Select(SelectionItems &items, int capacity, const SelectionOptions &, double work_limit, SelectionScratch &,
+                    ArenaVector<size_t> &bag) const override
+        {
+            return SelectCountFirst(items, capacity, workLimit(work_limit), bag);
+        }
+    };
+
+    class weightClassSelector : public ShipmentSelector
+    {
+    public:
+        SelectionEngine Engine() const override { return SelectionEngine::WeightClasses; }
+        const char *Name() const override { return "weight-classes"; }
+
+        // At most log2(n) bundles per package count, each one relaxing the whole row.
+        SelectionCost EstimateCost(const SelectionProfile &profile, const SelectionOptions &) const override
+        {
+            const double bundles = std::min<double>(profile.items, std::log2(profile.items + 1.0) * (profile.max_count + 1));
+            return SelectionCost{bundles * cells(profile), cells(profile) * (sizeof(uint64_t) + bundles / 8)};
+        }
+
+        bool Select(SelectionItems &items, int capacity, const SelectionOptions &, double, SelectionScratch &,
+                    ArenaVector<size_t> &bag) const override
+        {
+            bag = SelectByWeightClasses(items, capacity);
+            return true;
+        }
+    };
+
+    class sparseSelector : public ShipmentSelector
+    {
+    public:
+        SelectionEngine Engine() const override { return SelectionEngine::Sparse; }
+        const char *Name() const override { return "sparse"; }
+
+        // Frontier sizes cannot be told in advance. With kSparseCapacityPerItem units per package they tend to stay
+        // far below the row, so the frontier is optimistically taken as 1 / kSparseWorkShare of the dense work and
+        // the engine gives up once it merges more than its limit allows.
+        SelectionCost EstimateCost(const SelectionProfile &profile, const SelectionOptions &) const override
+        {
+            if (static_cast<size_t>(profile.capacity) / std::max<size_t>(profile.items, 1) < kSparseCapacityPerItem)
+            {
+                return SelectionCost{kUnbounded, 0};
+            }
+            const double work = profile.items * cells(profile) / kSparseWorkShare;
+            return SelectionCost{work, work / kSparseWorkShare * 2 * sizeof(long long)};
+        }
+
+        bool Select(SelectionItems &items, int capacity, const SelectionOptions &, double work_limit, SelectionScratch &,
+                    ArenaVector<size_t> &bag) const override
+        {
+            return SelectBySparseFrontier(items, capacity, workLimit(work_limit) / kSparseWorkShare, bag);
+        }
+    };
+
+    class meetInTheMiddleSelector : public ShipmentSelector
+    {
+    public:
+        SelectionEngine Engine() const override { return SelectionEngine::MeetInTheMiddle; }
+        const char *Name() const override { return "meet-in-the-middle"; }
+
+        SelectionCost EstimateCost(const SelectionProfile &profile, const SelectionOptions &) const override
+        {
+            const long long work = MeetInTheMiddleWork(profile.items, profile.max_count);
+            if (work < 0)
+            {
+                return SelectionCost{kUnbounded, 0};
+            }
+            return SelectionCost{static_cast<double>(work), static_cast<double>(work)};
+        }
+
+        bool Select(SelectionItems &items, int capacity, const SelectionOptions &, double, SelectionScratch &,
+                    ArenaVector<size_t> &bag) const override
+        {
+            return SelectMeetInTheMiddle(items, capacity, bag);
+        }
+    };
+
+    class branchAndBoundSelector : public ShipmentSelector
+    {
+    public:
+        SelectionEngine Engine() const override { return SelectionEngine::BranchAndBound; }
+        const char *Name() const override { return "branch-and-bound"; }
+
+        // The search can visit every k*-package shipment, only the time budget bounds it.
+        SelectionCost EstimateCost(const SelectionProfile &profile, const SelectionOptions &) const override
+        {
+            return SelectionCost{std::pow(2.0, static_cast<double>(profile.items)), profile.items * 2.0 * sizeof(size_t)};
+        }
+
+        // A search cut short by the time budget still returns its best shipment.
+        bool Select(SelectionItems &items, int capacity, const SelectionOptions &options, double, SelectionScratch &,
+                    ArenaVector<size_t> &bag) const override
+        {
+            SelectByBranchAndBound(items, capacity, options.time_budget, bag);
+            return true;
+        }
+    };
+
+    // Runs the exact selection on weights rounded up to multiples of about epsilon * C / (2 k*). A dense row then has
+    // about 2 k* / epsilon cells and every rounded bag stays within the capacity. Each of the k* packages loses less
+    // than one multiple, so when some shipment nearly fills the vehicle the bag misses it by at most epsilon * C / 2.
+    // The bag is only kept if it ships k* packages weighing at least (1 - epsilon) times an upper bound on the best
+    // weight, the capacity or the k* heaviest packages, whichever is less.
+    class approximateSelector : public ShipmentSelector
+    {
+        const SelectorRegistry &registry;
+
+    public:
+        explicit approximateSelector(const SelectorRegistry &registry) : registry(registry) {}
+
+        SelectionEngine Engine() const override { return SelectionEngine::Approximate; }
+        const char *Name() const override { return "approximate"; }
+
+        SelectionCost EstimateCost(const SelectionProfile &profile, const SelectionOptions &options) const override
+        {
+            const double rounded_cells = std::min(cells(profile), 2.0 * (profile.max_count + 1) / options.epsilon);
+            return SelectionCost{profile.items * rounded_cells, rounded_cells * (sizeof(uint64_t) + profile.items / 8.0)};
+        }
+
+        bool Select(SelectionItems &items, int capacity, const SelectionOptions &options, double, SelectionScratch &scratch,
+                    ArenaVector<size_t> &bag) const override
+        {
+            const double epsilon = options.epsilon;
+            auto lightest_sums = LightestWeightSums(items);
+            const int max_count = MaxShipmentCount(lightest_sums, capacity);
+            // The k* lightest packages must still fit once rounded, each growing by less than one multiple.
+            const double slack = static_cast<double>(capacity - lightest_sums[max_count]);
+            const double granularity = std::min(epsilon * capacity / 2, slack) / (max_count + 1);
+
+            if (max_count == 0 || granularity < 2)
+            {
+                return false;
+            }
+
+            SelectionItems rounded(items);
+            for (size_t i = 0; i < rounded.size(); i++)
+            {
+                rounded[i].idx = i;
+            }
+            const int rounded_capacity = RoundWeightsUp(rounded, capacity, static_cast<int>(granularity));
+
+            ArenaVector<size_t> positions;
+            SelectionDecision decision;
+            registry.SelectCheapest(rounded, rounded_capacity, options, scratch, positions, decision);
+
+            if (positions.size() != static_cast<size_t>(max_count))
+            {
+                return false;
+            }
+
+            long long weight = 0;
+            bag.clear();
+            for (auto &&pos : positions)
+            {
+                weight += items[pos].weight;
+                bag.push_back(items[pos].idx);
+            }
+
+            const long long heaviest = lightest_sums.back() - lightest_sums[items.size() - max_count];
+            return weight >= (1 - epsilon) * std::min<long long>(capacity, heaviest);
+        }
+    };
+}
+
+SelectionProfile ProfileSelection(const SelectionItems &items, int capacity)
+{
+    SelectionProfile profile;
+    profile.items = items.size();
+    profile.capacity = capacity;
+
+    const auto lightest_sums = LightestWeightSums(items);
+    profile.max_count = MaxShipmentCount(lightest_sums, capacity);
+    if (profile.max_count == 0)
+    {
+        return profile;
+    }
+
+    // The j-th lightest weight is sums[j + 1] - sums[j], and the heaviest of the k* lightest sets the threshold.
+    const long long threshold = lightest_sums[profile.max_count] - lightest_sums[profile.max_count - 1];
+    profile.slack = static_cast<int>(capacity - lightest_sums[profile.max_count]);
+
+    size_t base = 0, outside = 0;
+    for (size_t j = 0; j < items.size(); j++)
+    {
+        const long long weight = lightest_sums[j + 1] - lightest_sums[j];
+        if (j < static_cast<size_t>(profile.max_count))
+        {
+            base += threshold - weight <= profile.slack;
+        }
+        else if (weight - threshold <= profile.slack)
+        {
+            outside++;
+        }
+        else
+        {
+            break;
+        }
+    }
+    profile.swap_candidates = base + outside;
+    profile.swap_span = std::min(base, outside);
+
+    for (int k = 0; k <= profile.max_count; k++)
+    {
+        profile.count_window_cells += capacity - lightest_sums[profile.max_count - k] - lightest_sums[k] + 1.0;
+    }
+    return profile;
+}
+
+void SelectorRegistry::Register(std::unique_ptr<ShipmentSelector> selector)
+{
+    selectors.push_back(std::move(selector));
+}
+
+const ShipmentSelector *SelectorRegistry::Find(SelectionEngine engine) const
+{
+    for (auto &&selector : selectors)
+    {
+        if (selector->Engine() == engine)
+        {
+            return selector.get();
+        }
+    }
+    return nullptr;
+}
+
+const ShipmentSelector *SelectorRegistry::Find(const std::string &name) const
+{
+    for (auto &&selector : selectors)
+    {
+        if (name == selector->Name())
+        {
+            return selector.get();
+        }
+    }
+    return nullptr;
+}
+
+void SelectorRegistry::SelectCheapest(SelectionItems &items, int capacity, const SelectionOptions &options,
+                                      SelectionScratch &scratch, ArenaVector<size_t> &bag, SelectionDecision &decision) const
+{
+    struct rankedSelector
+    {
+        SelectionCost cost;
+        size_t order;
+        const ShipmentSelector *selector;
+    };
+
+    const SelectionProfile profile = ProfileSelection(items, capacity);
+    ArenaVector<rankedSelector> ranked;
+    for (auto &&selector : selectors)
+    {
+        const SelectionCost cost = selector->EstimateCost(profile, options);
+        const bool fits = cost.bytes <= options.decision_budget || selector->Engine() == SelectionEngine::DenseDP;
+        if (ReturnsKpBag(selector->Engine()) && cost.work < kUnbounded && fits)
+        {
+            ranked.push_back(rankedSelector{cost, ranked.size(), selector.get()});
+        }
+    }
+    // Registration order breaks ties, as a stable sort would.
+    std::sort(ranked.begin(), ranked.end(),
+              [](const rankedSelector &lhs, const rankedSelector &rhs)
+              {
+                  return lhs.cost.work < rhs.cost.work || (lhs.cost.work == rhs.cost.work && lhs.order < rhs.order);
+              });
+
+    for (size_t i = 0; i < ranked.size(); i++)
+    {
+        const double work_limit = i + 1 < ranked.size() ? ranked[i + 1].cost.work : kUnbounded;
+        if (ranked[i].selector->Select(items, capacity, options, work_limit, scratch, bag))
+        {
+            decision.engine = ranked[i].selector->Name();
+            decision.cost = ranked[i].cost;
+            decision.items = items.size();
+            return;
+        }
+    }
+}
+
+void RegisterStandardSelectors(SelectorRegistry &registry)
+{
+    registry.Register(std::unique_ptr<ShipmentSelector>(new bitsetSelector));
+    registry.Register(std::unique_ptr<ShipmentSelector>(new countFirstSelector));
+    registry.Register(std::unique_ptr<ShipmentSelector>(new weightClassSelector));
+    registry.Register(std::unique_ptr<ShipmentSelector>(new sparseSelector));
+    registry.Register(std::unique_ptr<ShipmentSelector>(new meetInTheMiddleSelector));
+    registry.Register(std::unique_ptr<ShipmentSelector>(new branchAndBoundSelector));
+    registry.Register(std::unique_ptr<ShipmentSelector>(new approximateSelector(registry)));
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include "selection.h"
+
+// One row of bits per item, bit j of row i is set when item i improved capacity j in kp.
+// Walking these rows back from max_carriable_weight rebuilds the selected bag.
+struct DecisionBitmap
+{
+    size_t words_per_item = 0;
+    std::vector<uint64_t> bits;
+
+    void resize(size_t no_of_items, int max_carriable_weight)
+    {
+        words_per_item = (static_cast<size_t>(max_carriable_weight) >> 6) + 1;
+        if (bits.size() < no_of_items * words_per_item)
+        {
+            bits.resize(no_of_items * words_per_item);
+        }
+    }
+
+    void clear(size_t item)
+    {
+        std::fill(bits.begin() + item * words_per_item, bits.begin() + (item + 1) * words_per_item, 0);
+    }
+
+    uint64_t *row(size_t item) { return bits.data() + item * words_per_item; }
+
+    bool test(size_t item, size_t capacity) const
+    {
+        return (bits[item * words_per_item + (capacity >> 6)] >> (capacity & 63)) & 1;
+    }
+};
+
+// The kp score row and decision bits, kept by a plan across its rounds.
+struct SelectionScratch
+{
+    std::vector<uint64_t> scores;
+    DecisionBitmap decisions;
+    // Second score row of the split sweep, see parallel_kp.h.
+    std::vector<uint64_t> spare;
+};
+
+// What the cost model knows of a round, once the weights are compressed. The k* lightest packages fix the largest
+// shipment count and leave slack units of the capacity, and a count-first swap can only involve the packages
+// whose gain against the heaviest of them fits in the slack. A k-package part of a best shipment weighs between
+// the k lightest and the capacity less the k* - k lightest, count_window_cells sums those ranges over k <= k*.
+struct SelectionProfile
+{
+    size_t items = 0;
+    int capacity = 0;
+    int max_count = 0;
+    int slack = 0;
+    size_t swap_candidates = 0;
+    size_t swap_span = 0;
+    double count_window_cells = 0;
+};
+
+SelectionProfile ProfileSelection(const SelectionItems &items, int capacity);
+
+// Estimated cost of one engine on one round : work in dense kp cell updates and peak memory in bytes.
+// Infinite work means the engine cannot take the round.
+struct SelectionCost
+{
+    double work;
+    double bytes;
+};
+
+// A selection engine behind a common interface, so Delivery_Time can pick one per round from a cost estimate.
+class ShipmentSelector
+{
+public:
+    virtual ~ShipmentSelector() {}
+
+    virtual SelectionEngine Engine() const = 0;
+
+    // Name used by --engine and in the metrics output.
+    virtual const char *Name() const = 0;
+
+    virtual SelectionCost EstimateCost(const SelectionProfile &profile, const SelectionOptions &options) const = 0;
+
+    // Fills bag, listed from the highest index down, with the weights of items compressed in place. Returns false
+    // when the engine gives up, for instance past work_limit dense cell updates, leaving bag unspecified.
+    virtual bool Select(SelectionItems &items, int capacity, const SelectionOptions &options, double work_limit,
+                        SelectionScratch &scratch, ArenaVector<size_t> &bag) const = 0;
+};
+
+// The engine a round ran on and what the cost model expected it to cost.
+struct SelectionDecision
+{
+    const char *engine = "";
+    SelectionCost cost = {0, 0};
+    size_t items = 0;
+};
+
+class SelectorRegistry
+{
+    std::vector<std::unique_ptr<ShipmentSelector>> selectors;
+
+public:
+    void Register(std::unique_ptr<ShipmentSelector> selector);
+
+    const ShipmentSelector *Find(SelectionEngine engine) const;
+    const ShipmentSelector *Find(const std::string &name) const;
+
+    const std::vector<std::unique_ptr<ShipmentSelector>> &Selectors() const { return selectors; }
+
+    // Runs the engines returning the kp bag that fit in options.decision_budget bytes, cheapest estimate first.
+    // Each one may spend up to the estimate of the next before giving up, and the last one runs to the end. The
+    // dense kp always takes part, past the budget it falls back to the linear-memory sweep.
+    void SelectCheapest(SelectionItems &items, int capacity, const SelectionOptions &options,
+                        SelectionScratch &scratch, ArenaVector<size_t> &bag, SelectionDecision &decision) const;
+};
+
+// Adds the bitset, count-first, weight-class, sparse, meet-in-the-middle, branch-and-bound and approximate engines.
+// The dense kp comes from Delivery, which owns it.
+void RegisterStandardSelectors(SelectorRegistry &registry);
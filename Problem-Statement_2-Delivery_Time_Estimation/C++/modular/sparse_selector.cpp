@@ -0,0 +1,109 @@
+#include <algorithm>
+#include "sparse_selector.h"
+
+namespace
+{
+    struct frontierState
+    {
+        int weight;
+        int count;
+    };
+
+    bool operator<(const frontierState &lhs, const frontierState &rhs)
+    {
+        return lhs.weight < rhs.weight || (lhs.weight == rhs.weight && lhs.count < rhs.count);
+    }
+
+    bool operator==(const frontierState &lhs, const frontierState &rhs)
+    {
+        return lhs.weight == rhs.weight && lhs.count == rhs.count;
+    }
+}
+
+bool SelectBySparseFrontier(const SelectionItems &items, int max_carriable_weight, long long work_limit,
+                            ArenaVector<size_t> &bag)
+{
+    long long work = 0;
+    ArenaVector<frontierState> frontier(1, frontierState{0, 0}), merged;
+
+    // created[created_from[p] .. created_from[p + 1]) holds the states package p added to the frontier, by weight.
+    ArenaVector<frontierState> created;
+    ArenaVector<size_t> created_from(1, 0);
+
+    for (size_t p = 0; p < items.size(); p++)
+    {
+        const int weight = items[p].weight;
+        merged.clear();
+
+        // Only the prefix of the frontier that still fits once the package is added gets a shifted copy.
+        size_t a = 0, b = 0, shifted = 0;
+        while (shifted < frontier.size() && frontier[shifted].weight <= max_carriable_weight - weight)
+        {
+            shifted++;
+        }
+
+        int running_count = 0;
+        while (a < frontier.size() || b < shifted)
+        {
+            frontierState next{0, 0};
+            bool is_new = false;
+
+            if (b == shifted || (a < frontier.size() && frontier[a].weight < frontier[b].weight + weight))
+            {
+                next = frontier[a++];
+            }
+            else
+            {
+                frontierState candidate{frontier[b].weight + weight, frontier[b].count + 1};
+                b++;
+                is_new = true;
+
+                if (a < frontier.size() && frontier[a].weight == candidate.weight)
+                {
+                    is_new = candidate.count > frontier[a].count;
+                    next = is_new ? candidate : frontier[a];
+                    a++;
+                }
+                else
+                {
+                    next = candidate;
+                }
+            }
+
+            // A state survives only while no lighter state holds more packages.
+            if (next.count >= running_count)
+            {
+                running_count = next.count;
+                merged.push_back(next);
+                if (is_new)
+                {
+                    created.push_back(next);
+                }
+            }
+        }
+
+        work += static_cast<long long>(merged.size());
+        if (work > work_limit)
+        {
+            return false;
+        }
+        frontier.swap(merged);
+        created_from.push_back(created.size());
+    }
+
+    bag.clear();
+    frontierState target = frontier.back();
+
+    for (size_t p = items.size(); p-- > 0 && target.count > 0;)
+    {
+        auto first = created.begin() + created_from[p], last = created.begin() + created_from[p + 1];
+        auto found = std::lower_bound(first, last, target);
+
+        if (found != last && *found == target)
+        {
+            bag.push_back(items[p].idx);
+            target = frontierState{target.weight - items[p].weight, target.count - 1};
+        }
+    }
+    return true;
+}
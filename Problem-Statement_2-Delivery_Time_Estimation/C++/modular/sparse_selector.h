@@ -0,0 +1,18 @@
+#pragma once
+
+#include "selection.h"
+
+// Sparse selection engine for capacities far larger than the number of packages (weights in grams).
+// Instead of a dense row over every capacity it keeps the frontier of reachable (weight, count) states sorted by
+// weight, where a state is dropped as soon as some lighter state holds more packages. The frontier is exactly
+// the set of cells at which the dense kp row changes value, so its last entry is kp's best score. Each package
+// is merged in as a shifted copy of the frontier, and the states it creates are logged so that the kp bag can be
+// rebuilt from the last package down.
+// Gives up and returns false once the frontiers merged so far hold more than work_limit states in total.
+bool SelectBySparseFrontier(const SelectionItems &items, int max_carriable_weight, long long work_limit,
+                            ArenaVector<size_t> &bag);
+
+// Auto tries the sparse engine once there are at least this many capacity units per package, and lets it merge
+// at most 1 / kSparseWorkShare of the cells the dense kp would relax, a frontier state costing several cells.
+const int kSparseCapacityPerItem = 1024;
+const int kSparseWorkShare = 128;
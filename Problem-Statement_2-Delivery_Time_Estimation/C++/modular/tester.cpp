@@ -3,7 +3,39 @@
 #include <string>
 #include <cassert>
 #include <array>
+#include <limits>
+#include <thread>
 #include "delivery_logic.h"
+#include "shipment_cache.h"
+#include "two_constraint_selector.h"
+#include "meet_in_the_middle_selector.h"
+#include "kp_kernel.h"
+#include "tiled_kp.h"
+
+// Packages pkg_id0, pkg_id1, ... with weights drawn from [min_weight, min_weight + weight_range) by a fixed LCG,
+// so every run sees the same manifest.
+std::vector<Package> random_packages(unsigned seed, int no_of_packages, int min_weight, int weight_range)
+{
+    std::vector<Package> pkgs;
+    for (int i = 0; i < no_of_packages; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        pkgs.emplace_back("pkg_id" + std::to_string(i), min_weight + static_cast<int>((seed >> 8) % weight_range), 10 + i);
+    }
+    return pkgs;
+}
+
+// Bag of one registered engine over every package that fits, with the weights compressed like in a round.
+// Returns false when the engine gives up.
+bool select_with_engine(SelectionEngine engine, std::vector<Package> &pkgs, int max_carriable_weight,
+                        const SelectionOptions &options, ArenaVector<size_t> &bag)
+{
+    WaitingPackages waiting(pkgs, max_carriable_weight);
+    SelectionItems items = waiting.All();
+    const int capacity = CompressCapacity(items, max_carriable_weight);
+    SelectionScratch scratch;
+    return Delivery::Selectors().Find(engine)->Select(items, capacity, options, std::numeric_limits<double>::infinity(), scratch, bag);
+}
 
 void malformed_json_offers()
 {
@@ -234,127 +266,1192 @@ void package_time_computation_with_weight_tie()
     std::cout << "Test : package_time_computation PASSED" << '\n';
 }
 
-void workflow_integration_test()
+void package_time_computation_with_bitset_engine()
 {
-    std::stringstream oss, iss;
-    Delivery::SetUpDelivery("json_files\\offers.json", false, oss);
-    iss << "100 5\nPKG1 50 30 OFR001\nPKG2 75 125 OFFR0008\nPKG3 175 100 OFFR003\nPKG4 110 60 OFFR002\nPKG5 155 95 NA \n2 70 200\n";
-    Delivery::ExecuteWorkflow(oss, iss);
-    std::string output = "";
-    std::array<std::pair<std::string, std::string>, 8> expected_errors =
+    std::vector<float> expected_delivery_time = {0.42f, 1.78f, 1.42f, 4.41f, 4.19f, 1.24f};
+    std::vector<Package> pkgs =
         {
-            std::make_pair("PKG1", "PKG1 0.00 750.00 3.98"),
-            std::make_pair("PKG2", "PKG2 0.00 1475.00 1.78"),
-            std::make_pair("PKG3", "PKG3 0.00 2350.00 1.42"),
-            std::make_pair("PKG4", "PKG4 105.00 1395.00 0.85"),
-            std::make_pair("PKG5", "PKG5 0.00 2125.00 4.19")};
+            Package("pkg_id01", 50, 30),
+            Package("pkg_id02", 75, 125),
+            Package("pkg_id03", 175, 100),
+            Package("pkg_id04", 110, 60),
+            Package("pkg_id05", 155, 95),
+            Package("pkg_id06", 60, 87),
+        };
+    const int no_of_vehicles = 2, max_speed = 70, max_carriable_weight = 200;
+    SelectionOptions options;
+    options.engine = SelectionEngine::Bitset;
+    Delivery::Delivery_Time(pkgs, no_of_vehicles, max_speed, max_carriable_weight, options);
 
-    int idx = 0;
+    for (size_t i = 0; i < pkgs.size(); i++)
+    {
+        if (pkgs[i].getDeliveryTime() != expected_delivery_time[i])
+        {
+            std::cout << "Test : package_time_computation_with_bitset_engine FAILED" << '\n';
+            return;
+        }
+    }
+    std::cout << "Test : package_time_computation_with_bitset_engine PASSED" << '\n';
+}
 
-    std::cout << "Test : workflow_integration_test : " << '\n';
+void kp_kernel_matches_the_scalar_sweep()
+{
+    const int capacity = 300;
+    std::vector<uint64_t> scores(capacity + 1, 0), expected(capacity + 1, 0), previous, into(capacity + 1), expected_into(capacity + 1);
+    std::vector<uint64_t> decisions((capacity + 64) / 64), expected_decisions((capacity + 64) / 64);
     bool testFailed = false;
 
-    while (std::getline(oss, output, '\n'))
+    // Weights below the vector width take the scalar tail, the others the vector blocks. Each relaxes the row of the
+    // items before it, in place over the whole row and double-buffered over ranges off the lane boundaries.
+    int item = 0;
+    for (int weight : {1, 2, 3, 4, 5, 7, 8, 13, 64, 100, 3, 250})
     {
-        if (output.compare(expected_errors[idx].second) != 0)
+        const int count = 1 + item++ % 3;
+        const uint64_t score = PackScore(count, weight);
+        previous = scores;
+
+        std::fill(decisions.begin(), decisions.end(), 0);
+        std::fill(expected_decisions.begin(), expected_decisions.end(), 0);
+        RelaxScores(scores.data(), decisions.data(), capacity, weight, count);
+        for (int j = capacity; j >= weight; j--)
         {
-            std::cout << "\t Values for Package Id : " << expected_errors[idx].first << " does not Match" << '\n';
-            testFailed = true;
+            if (expected[j - weight] + score > expected[j])
+            {
+                expected[j] = expected[j - weight] + score;
+                expected_decisions[j / 64] |= uint64_t{1} << (j % 64);
+            }
+        }
+        testFailed |= scores != expected || decisions != expected_decisions;
+
+        for (auto &&range : {std::make_pair(0, capacity), std::make_pair(3, 77), std::make_pair(13, 201), std::make_pair(129, 299)})
+        {
+            std::fill(decisions.begin(), decisions.end(), 0);
+            std::fill(expected_decisions.begin(), expected_decisions.end(), 0);
+            into = expected_into = previous;
+            RelaxScoresInto(previous.data(), into.data(), decisions.data(), range.first, range.second, weight, count);
+            for (int j = range.first; j <= range.second; j++)
+            {
+                if (j >= weight && previous[j - weight] + score > previous[j])
+                {
+                    expected_into[j] = previous[j - weight] + score;
+                    expected_decisions[j / 64] |= uint64_t{1} << (j % 64);
+                }
+            }
+            testFailed |= into != expected_into || decisions != expected_decisions;
         }
-        idx++;
     }
+
     if (testFailed)
     {
-        std::cout << "\t Test workflow_integration_test : FAILED" << '\n';
+        std::cout << "Test : kp_kernel_matches_the_scalar_sweep FAILED" << '\n';
+        return;
     }
-    else
+    std::cout << "Test : kp_kernel_matches_the_scalar_sweep PASSED" << '\n';
+}
+
+void shipment_selection_with_compressed_capacity()
+{
+    const ShipmentSelector *dense = Delivery::Selectors().Find(SelectionEngine::DenseDP);
+    SelectionOptions options;
+    SelectionScratch scratch;
+    bool testFailed = false;
+
+    // Weights sharing a divisor of 25, against capacities off that divisor and above the total weight.
+    std::vector<Package> pkgs;
+    long long total_weight = 0;
+    for (auto &&pkg : random_packages(31, 40, 1, 40))
     {
-        std::cout << "\t Test workflow_integration_test : PASSED" << '\n';
+        pkgs.emplace_back("pkg_id" + std::to_string(pkgs.size()), 25 * pkg.getWeight(), pkg.getDistance());
+        total_weight += pkgs.back().getWeight();
+    }
+    for (int max_carriable_weight : {1000, 1010, 4999, static_cast<int>(total_weight), static_cast<int>(total_weight) + 77})
+    {
+        WaitingPackages waiting(pkgs, max_carriable_weight);
+        SelectionItems compressed = waiting.All(), uncompressed = waiting.All();
+        long long fitting_weight = 0;
+        for (auto &&item : uncompressed)
+        {
+            fitting_weight += item.weight;
+        }
+
+        int divisor = 0;
+        const int capacity = CompressCapacity(compressed, max_carriable_weight, divisor);
+        testFailed |= divisor != 25 || capacity != std::min<long long>(max_carriable_weight, fitting_weight) / 25;
+
+        ArenaVector<size_t> bag, expected_bag;
+        dense->Select(compressed, capacity, options, 0, scratch, bag);
+        dense->Select(uncompressed, max_carriable_weight, options, 0, scratch, expected_bag);
+        testFailed |= bag != expected_bag;
+    }
+
+    if (testFailed)
+    {
+        std::cout << "Test : shipment_selection_with_compressed_capacity FAILED" << '\n';
+        return;
     }
+    std::cout << "Test : shipment_selection_with_compressed_capacity PASSED" << '\n';
 }
 
-void workflow_integration_test_with_weight_tie()
+void shipment_selection_with_weight_classes()
 {
-    std::stringstream oss, iss;
-    Delivery::SetUpDelivery("json_files\\offers.json", false, oss);
-    iss << "100 6\nPKG1 50 30 OFR001\nPKG2 75 125 OFFR0008\nPKG3 175 100 OFFR003\nPKG4 110 60 OFFR002\nPKG5 155 95 NA \nPKG6 60 87 OFFR002 \n3 85 200\n";
-    Delivery::ExecuteWorkflow(oss, iss);
-    std::string output = "";
-    std::array<std::pair<std::string, std::string>, 8> expected_errors =
+    std::vector<size_t> expected_bag = {2, 1};
+    std::vector<Package> pkgs =
         {
-            std::make_pair("PKG1", "PKG1 0.00 750.00 0.35"),
-            std::make_pair("PKG2", "PKG2 0.00 1475.00 1.47"),
-            std::make_pair("PKG3", "PKG3 0.00 2350.00 1.17"),
-            std::make_pair("PKG4", "PKG4 105.00 1395.00 2.92"),
-            std::make_pair("PKG5", "PKG5 0.00 2125.00 1.11"),
-            std::make_pair("PKG6", "PKG6 79.45 1055.55 1.02")
-        };
+            Package("pkg_id01", 50, 30),
+            Package("pkg_id02", 50, 10),
+            Package("pkg_id03", 50, 20),
+            Package("pkg_id04", 100, 5)};
+    const int max_carriable_weight = 100;
+    SelectionOptions options;
+    options.engine = SelectionEngine::WeightClasses;
 
-    int idx = 0;
+    if (Delivery::SelectShipment(pkgs, max_carriable_weight, options) != expected_bag)
+    {
+        std::cout << "Test : shipment_selection_with_weight_classes FAILED" << '\n';
+        return;
+    }
+    std::cout << "Test : shipment_selection_with_weight_classes PASSED" << '\n';
+}
 
-    std::cout << "Test : workflow_integration_test_with_weight_tie : " << '\n';
+void shipment_selection_with_exhausted_time_budget()
+{
+    std::vector<size_t> expected_bag = {2, 1};
+    std::vector<Package> pkgs =
+        {
+            Package("pkg_id01", 90, 30),
+            Package("pkg_id02", 40, 10),
+            Package("pkg_id03", 30, 20),
+            Package("pkg_id04", 60, 5)};
+    const int max_carriable_weight = 100;
+    SelectionOptions options;
+    options.engine = SelectionEngine::BranchAndBound;
+    options.time_budget = std::chrono::microseconds::zero();
+
+    if (Delivery::SelectShipment(pkgs, max_carriable_weight, options) != expected_bag)
+    {
+        std::cout << "Test : shipment_selection_with_exhausted_time_budget FAILED" << '\n';
+        return;
+    }
+    std::cout << "Test : shipment_selection_with_exhausted_time_budget PASSED" << '\n';
+}
+
+void shipment_selection_with_parallel_sweep()
+{
+    std::vector<Package> pkgs = random_packages(12345, 60, 1000, 49000);
+    const int max_carriable_weight = 200000;
+    SelectionOptions serial, parallel;
+    serial.engine = parallel.engine = SelectionEngine::DenseDP;
+    parallel.threads = 4;
+
+    if (Delivery::SelectShipment(pkgs, max_carriable_weight, parallel) != Delivery::SelectShipment(pkgs, max_carriable_weight, serial))
+    {
+        std::cout << "Test : shipment_selection_with_parallel_sweep FAILED" << '\n';
+        return;
+    }
+    std::cout << "Test : shipment_selection_with_parallel_sweep PASSED" << '\n';
+}
+
+void package_time_computation_with_concurrent_parallel_sweeps()
+{
+    std::vector<Package> expected = random_packages(4242, 60, 1000, 49000);
+    const int no_of_vehicles = 2, max_speed = 70, max_carriable_weight = 200000;
+    SelectionOptions serial;
+    serial.engine = SelectionEngine::DenseDP;
+    Delivery::Delivery_Time(expected, no_of_vehicles, max_speed, max_carriable_weight, serial);
+
+    // Two plans splitting their sweeps across different thread counts at once must not share a pool.
+    bool testFailed[2] = {false, false};
+    auto plan = [&](int worker, unsigned threads)
+    {
+        SelectionOptions options = serial;
+        options.threads = threads;
+        for (int repeat = 0; repeat < 5; repeat++)
+        {
+            std::vector<Package> pkgs = random_packages(4242, 60, 1000, 49000);
+            Delivery::Delivery_Time(pkgs, no_of_vehicles, max_speed, max_carriable_weight, options);
+            for (size_t i = 0; i < pkgs.size(); i++)
+            {
+                testFailed[worker] |= pkgs[i].getDeliveryTime() != expected[i].getDeliveryTime();
+            }
+        }
+    };
+    std::thread first(plan, 0, 2), second(plan, 1, 3);
+    first.join();
+    second.join();
+
+    if (testFailed[0] || testFailed[1])
+    {
+        std::cout << "Test : package_time_computation_with_concurrent_parallel_sweeps FAILED" << '\n';
+        return;
+    }
+    std::cout << "Test : package_time_computation_with_concurrent_parallel_sweeps PASSED" << '\n';
+}
+
+void shipment_selection_with_tiled_sweep()
+{
+    // Rows wide enough for the tiled sweep to pay off are too big for a test, so the kernel is run directly on a
+    // narrower one.
+    std::vector<Package> pkgs = random_packages(54321, 80, 1, 9000);
+    const int max_carriable_weight = 300000;
+    WaitingPackages waiting(pkgs, max_carriable_weight);
+    SelectionItems items = waiting.All();
+    const size_t words_per_item = (static_cast<size_t>(max_carriable_weight) >> 6) + 1;
+
+    std::vector<uint64_t> scores(max_carriable_weight + 1, 0), expected_scores(scores);
+    std::vector<uint64_t> decisions(items.size() * words_per_item, 0), expected_decisions(decisions);
+    TiledRelaxScores(items, max_carriable_weight, scores.data(), decisions.data(), words_per_item, TiledBlockCells());
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        RelaxScores(expected_scores.data(), expected_decisions.data() + i * words_per_item, max_carriable_weight, items[i].weight);
+    }
+
+    if (scores != expected_scores || decisions != expected_decisions)
+    {
+        std::cout << "Test : shipment_selection_with_tiled_sweep FAILED" << '\n';
+        return;
+    }
+    std::cout << "Test : shipment_selection_with_tiled_sweep PASSED" << '\n';
+}
+
+void shipment_selection_with_decision_budget()
+{
+    std::vector<Package> pkgs = random_packages(2024, 100, 1, 300);
+    const int max_carriable_weight = 5000;
+    SelectionOptions unbounded;
+    unbounded.engine = SelectionEngine::DenseDP;
+
+    // Auto still runs the dense kp, through the linear-memory sweep, once no engine fits the budget.
+    for (auto engine : {SelectionEngine::DenseDP, SelectionEngine::Auto})
+    {
+        SelectionOptions bounded;
+        bounded.engine = engine;
+        bounded.decision_budget = 1024;
+
+        if (Delivery::SelectShipment(pkgs, max_carriable_weight, bounded) != Delivery::SelectShipment(pkgs, max_carriable_weight, unbounded))
+        {
+            std::cout << "Test : shipment_selection_with_decision_budget FAILED" << '\n';
+            return;
+        }
+    }
+    std::cout << "Test : shipment_selection_with_decision_budget PASSED" << '\n';
+}
+
+void shipment_selection_with_fixed_capacities()
+{
+    std::vector<Package> pkgs = random_packages(777, 150, 1, 250);
+    SelectionOptions fixed, dynamic;
+    fixed.engine = dynamic.engine = SelectionEngine::DenseDP;
+    dynamic.fixed_capacities = false;
+
+    for (int max_carriable_weight : {200, 500, 1000})
+    {
+        if (Delivery::SelectShipment(pkgs, max_carriable_weight, fixed) != Delivery::SelectShipment(pkgs, max_carriable_weight, dynamic))
+        {
+            std::cout << "Test : shipment_selection_with_fixed_capacities FAILED" << '\n';
+            return;
+        }
+    }
+    std::cout << "Test : shipment_selection_with_fixed_capacities PASSED" << '\n';
+}
+
+void shipment_selection_with_count_first_engine()
+{
+    SelectionOptions options;
     bool testFailed = false;
 
-    while (std::getline(oss, output, '\n'))
+    // Narrow weight ranges leave many shipments of the best count, only their weight and kp's walk tell them apart.
+    for (unsigned seed = 1; seed <= 20; seed++)
     {
-        if (output.compare(expected_errors[idx].second) != 0)
+        std::vector<Package> pkgs = random_packages(seed, 40, 20 + static_cast<int>(seed), 10 * static_cast<int>(seed));
+        for (int max_carriable_weight : {200, 333, 1000})
         {
-            std::cout << "\t Values for Package Id : " << expected_errors[idx].first << " does not Match" << '\n';
-            testFailed = true;
+            ArenaVector<size_t> count_first, dense;
+            testFailed |= !select_with_engine(SelectionEngine::CountFirst, pkgs, max_carriable_weight, options, count_first);
+            select_with_engine(SelectionEngine::DenseDP, pkgs, max_carriable_weight, options, dense);
+            testFailed |= count_first != dense;
         }
-        idx++;
     }
+
     if (testFailed)
     {
-        std::cout << "\t Test workflow_integration_test_with_weight_tie : FAILED" << '\n';
+        std::cout << "Test : shipment_selection_with_count_first_engine FAILED" << '\n';
+        return;
     }
-    else
+    std::cout << "Test : shipment_selection_with_count_first_engine PASSED" << '\n';
+}
+
+void shipment_selection_with_sparse_engine()
+{
+    SelectionOptions options;
+    bool testFailed = false;
+
+    // Weights in grams : a few packages against a capacity of millions, where the frontier stays short.
+    for (unsigned seed = 1; seed <= 5; seed++)
     {
-        std::cout << "\t Test workflow_integration_test_with_weight_tie : PASSED" << '\n';
+        std::vector<Package> pkgs = random_packages(seed, 24, 1000, 400000);
+        for (int max_carriable_weight : {1000000, 2500000})
+        {
+            ArenaVector<size_t> sparse, dense;
+            testFailed |= !select_with_engine(SelectionEngine::Sparse, pkgs, max_carriable_weight, options, sparse);
+            select_with_engine(SelectionEngine::DenseDP, pkgs, max_carriable_weight, options, dense);
+            testFailed |= sparse != dense;
+        }
+    }
+
+    if (testFailed)
+    {
+        std::cout << "Test : shipment_selection_with_sparse_engine FAILED" << '\n';
+        return;
     }
+    std::cout << "Test : shipment_selection_with_sparse_engine PASSED" << '\n';
 }
 
-void workflow_integration_test_with_package_weight_greater_than_max_carriable_weight()
+void shipment_selection_with_meet_in_the_middle_engine()
 {
-    std::stringstream oss, iss;
-    Delivery::SetUpDelivery("modular\\json_files\\offers.json", false, oss);
-    iss << "100 6\nPKG1 50 30 OFR001\nPKG2 75 125 OFFR0008\nPKG3 201 100 OFFR003\nPKG4 110 60 OFFR002\nPKG5 155 95 NA \nPKG6 60 87 OFFR002 \n3 85 200\n";
-    Delivery::ExecuteWorkflow(iss, oss);
-    std::string output = "";
-    std::array<std::pair<std::string, std::string>, 8> expected_errors =
+    SelectionOptions options;
+    bool testFailed = false;
+
+    // A single package, the most packages the engine takes and runs of duplicate weights.
+    std::vector<std::vector<Package>> manifests =
         {
-            std::make_pair("PKG1", "PKG1 0.00 750.00 0.35"),
-            std::make_pair("PKG2", "PKG2 0.00 1475.00 1.47"),
-            std::make_pair("PKG3", "PKG3 0.00 2350.00 1.17"),
-            std::make_pair("PKG4", "PKG4 105.00 1395.00 2.92"),
-            std::make_pair("PKG5", "PKG5 0.00 2125.00 1.11"),
-            std::make_pair("PKG6", "PKG6 79.45 1055.55 1.02")};
+            random_packages(11, 1, 1000, 49000),
+            random_packages(12, static_cast<int>(kMeetInTheMiddleMaxItems), 1000, 49000),
+            random_packages(13, 30, 500, 3)};
+    for (auto &&pkgs : manifests)
+    {
+        for (int max_carriable_weight : {2600, 100000})
+        {
+            ArenaVector<size_t> meet_in_the_middle, dense;
+            testFailed |= !select_with_engine(SelectionEngine::MeetInTheMiddle, pkgs, max_carriable_weight, options, meet_in_the_middle);
+            select_with_engine(SelectionEngine::DenseDP, pkgs, max_carriable_weight, options, dense);
+            testFailed |= meet_in_the_middle != dense;
+        }
+    }
 
-    int idx = 0;
+    // One more package is past the limit and the engine gives up.
+    std::vector<Package> pkgs = random_packages(14, static_cast<int>(kMeetInTheMiddleMaxItems) + 1, 1000, 49000);
+    ArenaVector<size_t> bag;
+    testFailed |= select_with_engine(SelectionEngine::MeetInTheMiddle, pkgs, 100000, options, bag);
 
-    std::cout << "Test : workflow_integration_test_with_package_weight_greater_than_max_carriable_weight : " << '\n';
+    if (testFailed)
+    {
+        std::cout << "Test : shipment_selection_with_meet_in_the_middle_engine FAILED" << '\n';
+        return;
+    }
+    std::cout << "Test : shipment_selection_with_meet_in_the_middle_engine PASSED" << '\n';
+}
+
+void shipment_selection_with_approximate_engine()
+{
     bool testFailed = false;
 
-    while (std::getline(oss, output, '\n'))
+    // The approximate bag ships the best count and gives up at most epsilon of the best weight, never the capacity.
+    for (double epsilon : {0.01, 0.1})
     {
-        if (output.compare(expected_errors[idx].second) != 0)
+        SelectionOptions options;
+        options.epsilon = epsilon;
+        for (unsigned seed = 1; seed <= 10; seed++)
         {
-            std::cout << "\t Values for Package Id : " << expected_errors[idx].first << " does not Match Expected : " << expected_errors[idx].second << ", Actual : " << output << '\n';
-            testFailed = true;
+            std::vector<Package> pkgs = random_packages(seed, 60, 1000, 60000);
+            for (int max_carriable_weight : {100000, 1000000})
+            {
+                ArenaVector<size_t> approximate, dense;
+                testFailed |= !select_with_engine(SelectionEngine::Approximate, pkgs, max_carriable_weight, options, approximate);
+                select_with_engine(SelectionEngine::DenseDP, pkgs, max_carriable_weight, options, dense);
+
+                long long approximate_weight = 0, dense_weight = 0;
+                for (auto &&idx : approximate)
+                {
+                    approximate_weight += pkgs[idx].getWeight();
+                }
+                for (auto &&idx : dense)
+                {
+                    dense_weight += pkgs[idx].getWeight();
+                }
+                std::sort(approximate.begin(), approximate.end());
+                testFailed |= approximate.size() != dense.size() || approximate_weight > max_carriable_weight ||
+                              approximate_weight < (1 - epsilon) * dense_weight ||
+                              std::adjacent_find(approximate.begin(), approximate.end()) != approximate.end();
+            }
         }
-        else
+    }
+
+    if (testFailed)
+    {
+        std::cout << "Test : shipment_selection_with_approximate_engine FAILED" << '\n';
+        return;
+    }
+    std::cout << "Test : shipment_selection_with_approximate_engine PASSED" << '\n';
+}
+
+void planning_arena_reuses_its_block_after_release()
+{
+    PlanningArena arena(1024);
+    bool testFailed = false;
+
+    for (int round = 0; round < 4; round++)
+    {
         {
-            testFailed = false;
+            PlanningArena::Scope scope(&arena);
+            ArenaVector<long long> values;
+            for (int i = 0; i < 1000; i++)
+            {
+                values.push_back(i);
+            }
+            testFailed |= values.back() != 999 || reinterpret_cast<uintptr_t>(values.data()) % alignof(long long) != 0;
         }
-        idx++;
+        arena.Release();
+    }
+
+    // Once the rounds fit in the block kept by Release, the arena stops going to the global heap.
+    size_t upstream = arena.UpstreamAllocations();
+    {
+        PlanningArena::Scope scope(&arena);
+        ArenaVector<long long> values(1000);
     }
+    testFailed |= arena.UpstreamAllocations() != upstream;
+
     if (testFailed)
     {
-        std::cout << "\t Test workflow_integration_test_with_package_weight_greater_than_max_carriable_weight : FAILED" << '\n';
+        std::cout << "Test : planning_arena_reuses_its_block_after_release FAILED" << '\n';
+        return;
     }
-    else
+    std::cout << "Test : planning_arena_reuses_its_block_after_release PASSED" << '\n';
+}
+
+void planning_arena_copies_into_the_current_arena()
+{
+    PlanningArena plan_arena, round_arena;
+    PlanningArena::Scope plan_scope(&plan_arena);
+    ArenaVector<long long> values(1000, 7);
+    bool testFailed = false;
+
+    for (int round = 0; round < 4; round++)
     {
-        std::cout << "\t Test workflow_integration_test_with_package_weight_greater_than_max_carriable_weight : PASSED" << '\n';
+        size_t plan_allocations = plan_arena.Allocations();
+        {
+            PlanningArena::Scope round_scope(&round_arena);
+            ArenaVector<long long> copy(values);
+            testFailed |= copy.back() != 7 || copy.get_allocator() != ArenaVector<long long>::allocator_type();
+        }
+        // The copy lives on the round arena, so the plan arena does not grow with the rounds.
+        testFailed |= plan_arena.Allocations() != plan_allocations || round_arena.Allocations() == 0;
+        round_arena.Release();
+    }
+    testFailed |= round_arena.UpstreamAllocations() != 1;
+
+    if (testFailed)
+    {
+        std::cout << "Test : planning_arena_copies_into_the_current_arena FAILED" << '\n';
+        return;
+    }
+    std::cout << "Test : planning_arena_copies_into_the_current_arena PASSED" << '\n';
+}
+
+void waiting_packages_keep_the_plan_arena_bounded()
+{
+    std::vector<Package> pkgs;
+    for (int i = 0; i < 300; i++)
+    {
+        pkgs.push_back(Package("pkg_id" + std::to_string(i), 10 + i % 40, 10 + i));
+        pkgs.back().setVolume(5 + i % 13);
+    }
+    const int max_carriable_weight = 200;
+    VehicleLimits volume_limit;
+    volume_limit.max_volume = 60;
+    bool testFailed = false;
+
+    // Every round reads all waiting packages, like selectWithinLimits, and ships some. Only the round arena may grow
+    // with it.
+    for (const VehicleLimits &limits : {VehicleLimits(), volume_limit})
+    {
+        PlanningArena plan_arena, round_arena;
+        PlanningArena::Scope plan_scope(&plan_arena);
+        WaitingPackages waiting(pkgs, max_carriable_weight, limits);
+        const size_t plan_allocations = plan_arena.Allocations();
+        while (waiting.size())
+        {
+            {
+                PlanningArena::Scope round_scope(&round_arena);
+                SelectionItems items = waiting.All();
+                ArenaVector<size_t> best(1, items.front().idx);
+                if (limits.Any())
+                {
+                    SelectWithVehicleLimits(items, max_carriable_weight, limits, best);
+                }
+                waiting.Remove(best);
+            }
+            round_arena.Release();
+        }
+        testFailed |= plan_arena.Allocations() != plan_allocations || round_arena.UpstreamAllocations() != 1;
+    }
+
+    if (testFailed)
+    {
+        std::cout << "Test : waiting_packages_keep_the_plan_arena_bounded FAILED" << '\n';
+        return;
+    }
+    std::cout << "Test : waiting_packages_keep_the_plan_arena_bounded PASSED" << '\n';
+}
+
+void waiting_packages_prune_candidates_without_changing_the_bag()
+{
+    const ShipmentSelector *dense = Delivery::Selectors().Find(SelectionEngine::DenseDP);
+    SelectionOptions options;
+    SelectionScratch scratch;
+    bool testFailed = false;
+
+    // Identical packages, and weights a few grams apart so the lightest shipments tie at the end of a weight class.
+    std::vector<std::vector<Package>> manifests = {random_packages(21, 50, 40, 1), random_packages(22, 60, 48, 4), random_packages(23, 60, 30, 3)};
+    for (auto &&pkgs : manifests)
+    {
+        for (int max_carriable_weight : {120, 200, 203})
+        {
+            WaitingPackages waiting(pkgs, max_carriable_weight);
+            while (waiting.size())
+            {
+                SelectionItems candidates = waiting.Candidates(max_carriable_weight), all = waiting.All();
+                ArenaVector<size_t> pruned, bag;
+                dense->Select(candidates, CompressCapacity(candidates, max_carriable_weight), options, 0, scratch, pruned);
+                dense->Select(all, CompressCapacity(all, max_carriable_weight), options, 0, scratch, bag);
+                testFailed |= pruned != bag || candidates.size() > all.size();
+                if (bag.empty())
+                {
+                    break;
+                }
+                waiting.Remove(bag);
+            }
+        }
+    }
+
+    if (testFailed)
+    {
+        std::cout << "Test : waiting_packages_prune_candidates_without_changing_the_bag FAILED" << '\n';
+        return;
+    }
+    std::cout << "Test : waiting_packages_prune_candidates_without_changing_the_bag PASSED" << '\n';
+}
+
+void items_scanned_per_round_ignore_shipped_packages()
+{
+    std::vector<Package> pkgs;
+    for (int i = 0; i < 200; i++)
+    {
+        pkgs.push_back(Package("pkg_id" + std::to_string(i), 50, 10 + i % 7));
+    }
+    const int no_of_vehicles = 2, max_speed = 70, max_carriable_weight = 200;
+    Delivery::Delivery_Time(pkgs, no_of_vehicles, max_speed, max_carriable_weight);
+
+    // Four packages leave every round, no later round may read more of them than the first one.
+    const auto &scanned = Delivery::ItemsScannedPerRound();
+    bool testFailed = scanned.size() != 50;
+    for (auto &&items : scanned)
+    {
+        testFailed |= items > scanned.front();
+    }
+
+    if (testFailed)
+    {
+        std::cout << "Test : items_scanned_per_round_ignore_shipped_packages FAILED" << '\n';
+        return;
+    }
+    std::cout << "Test : items_scanned_per_round_ignore_shipped_packages PASSED" << '\n';
+}
+
+void items_scanned_per_round_of_concurrent_plans()
+{
+    bool testFailed[2] = {false, false};
+    auto plan = [&testFailed](int worker, int no_of_packages)
+    {
+        std::vector<Package> pkgs;
+        for (int i = 0; i < no_of_packages; i++)
+        {
+            pkgs.push_back(Package("pkg_id" + std::to_string(i), 50, 10 + i % 7));
+        }
+        for (int repeat = 0; repeat < 20; repeat++)
+        {
+            Delivery::Delivery_Time(pkgs, 2, 70, 200);
+            // Four packages leave every round, the other thread's plan must not show up in the counts.
+            testFailed[worker] |= Delivery::ItemsScannedPerRound().size() != static_cast<size_t>(no_of_packages / 4);
+        }
+    };
+    std::thread first(plan, 0, 200), second(plan, 1, 120);
+    first.join();
+    second.join();
+
+    if (testFailed[0] || testFailed[1])
+    {
+        std::cout << "Test : items_scanned_per_round_of_concurrent_plans FAILED" << '\n';
+        return;
+    }
+    std::cout << "Test : items_scanned_per_round_of_concurrent_plans PASSED" << '\n';
+}
+
+void package_time_computation_without_trivial_rounds()
+{
+    // The last round ships a lone package, turning the fast paths off must not change any time.
+    std::vector<float> expected_delivery_time = {3.98f, 1.78f, 1.42f, 0.85f, 4.19f};
+    std::vector<Package> pkgs =
+        {
+            Package("pkg_id01", 50, 30),
+            Package("pkg_id02", 75, 125),
+            Package("pkg_id03", 175, 100),
+            Package("pkg_id04", 110, 60),
+            Package("pkg_id05", 155, 95)};
+    const int no_of_vehicles = 2, max_speed = 70, max_carriable_weight = 200;
+    SelectionOptions options;
+    options.trivial_rounds = false;
+    Delivery::Delivery_Time(pkgs, no_of_vehicles, max_speed, max_carriable_weight, options);
+
+    for (size_t i = 0; i < pkgs.size(); i++)
+    {
+        if (pkgs[i].getDeliveryTime() != expected_delivery_time[i])
+        {
+            std::cout << "Test : package_time_computation_without_trivial_rounds FAILED" << '\n';
+            return;
+        }
+    }
+    std::cout << "Test : package_time_computation_without_trivial_rounds PASSED" << '\n';
+}
+
+void shipment_cache_replays_a_repeated_plan()
+{
+    std::vector<Package> first_plan =
+        {
+            Package("pkg_id01", 50, 30),
+            Package("pkg_id02", 75, 125),
+            Package("pkg_id03", 175, 100),
+            Package("pkg_id04", 110, 60),
+            Package("pkg_id05", 155, 95)};
+    // Same weights in the same order, carried by other packages.
+    std::vector<Package> second_plan =
+        {
+            Package("pkg_id11", 50, 40),
+            Package("pkg_id12", 75, 20),
+            Package("pkg_id13", 175, 10),
+            Package("pkg_id14", 110, 80),
+            Package("pkg_id15", 155, 35)};
+    const int no_of_vehicles = 2, max_speed = 70, max_carriable_weight = 200;
+    SelectionOptions options;
+    options.shipment_cache = 16;
+
+    auto &cache = SharedShipmentCache(options.shipment_cache);
+    cache.Clear();
+    Delivery::Delivery_Time(first_plan, no_of_vehicles, max_speed, max_carriable_weight, options);
+    const size_t misses = cache.Misses();
+    Delivery::Delivery_Time(second_plan, no_of_vehicles, max_speed, max_carriable_weight, options);
+
+    std::vector<Package> expected(second_plan);
+    options.shipment_cache = 0;
+    Delivery::Delivery_Time(expected, no_of_vehicles, max_speed, max_carriable_weight, options);
+
+    bool testFailed = misses == 0 || cache.Misses() != misses || cache.Hits() != misses;
+    for (size_t i = 0; i < second_plan.size(); i++)
+    {
+        testFailed |= second_plan[i].getDeliveryTime() != expected[i].getDeliveryTime();
+    }
+
+    if (testFailed)
+    {
+        std::cout << "Test : shipment_cache_replays_a_repeated_plan FAILED" << '\n';
+        return;
+    }
+    std::cout << "Test : shipment_cache_replays_a_repeated_plan PASSED" << '\n';
+}
+
+void shipment_cache_keeps_the_largest_requested_size()
+{
+    std::vector<Package> pkgs = random_packages(99, 30, 20, 100);
+    const int no_of_vehicles = 1, max_speed = 70, max_carriable_weight = 200;
+    SelectionOptions options;
+    options.shipment_cache = 16;
+
+    auto &cache = SharedShipmentCache(options.shipment_cache);
+    cache.Clear();
+    Delivery::Delivery_Time(pkgs, no_of_vehicles, max_speed, max_carriable_weight, options);
+    const size_t cached = cache.size();
+
+    // A plan asking for a smaller cache must not evict the bags of the first one.
+    SharedShipmentCache(2);
+    bool testFailed = cached <= 2 || cache.size() != cached;
+
+    if (testFailed)
+    {
+        std::cout << "Test : shipment_cache_keeps_the_largest_requested_size FAILED" << '\n';
+        return;
+    }
+    std::cout << "Test : shipment_cache_keeps_the_largest_requested_size PASSED" << '\n';
+}
+
+void shipment_selection_reports_its_engine()
+{
+    std::vector<Package> packages =
+        {
+            Package("pkg_id01", 50, 30),
+            Package("pkg_id02", 75, 125),
+            Package("pkg_id03", 175, 100),
+            Package("pkg_id04", 110, 60),
+            Package("pkg_id05", 155, 95)};
+    const int no_of_vehicles = 2, max_speed = 70, max_carriable_weight = 200;
+    std::vector<float> expected_delivery_time = {3.98f, 1.78f, 1.42f, 0.85f, 4.19f};
+    std::stringstream cheapest, forced;
+    SelectionOptions options;
+    options.trivial_rounds = false;
+    options.metrics = &cheapest;
+
+    Delivery::Delivery_Time(packages, no_of_vehicles, max_speed, max_carriable_weight, options);
+    const size_t rounds = Delivery::ItemsScannedPerRound().size();
+
+    // Every round names a registered engine and, when one is forced, that one.
+    const ShipmentSelector *count_first = Delivery::Selectors().Find("count-first");
+    options.engine = count_first->Engine();
+    options.metrics = &forced;
+    Delivery::Delivery_Time(packages, no_of_vehicles, max_speed, max_carriable_weight, options);
+
+    bool testFailed = false;
+    size_t lines = 0;
+    std::string line;
+    while (std::getline(cheapest, line, '\n'))
+    {
+        const size_t from = line.find(" : ") + 3;
+        testFailed |= Delivery::Selectors().Find(line.substr(from, line.find(',') - from)) == nullptr;
+        lines++;
+    }
+    testFailed |= lines != rounds;
+    while (std::getline(forced, line, '\n'))
+    {
+        testFailed |= line.find(" : count-first,") == std::string::npos;
+        lines--;
+    }
+    testFailed |= lines != 0;
+    for (size_t i = 0; i < packages.size(); i++)
+    {
+        testFailed |= packages[i].getDeliveryTime() != expected_delivery_time[i];
+    }
+
+    if (testFailed)
+    {
+        std::cout << "Test : shipment_selection_reports_its_engine FAILED" << '\n';
+        return;
+    }
+    std::cout << "Test : shipment_selection_reports_its_engine PASSED" << '\n';
+}
+
+void package_time_computation_with_volume_limit()
+{
+    std::vector<float> expected_delivery_time = {0.42f, 4.62f, 1.42f, 0.85f, 3.05f};
+    std::vector<Package> pkgs =
+        {
+            Package("pkg_id01", 50, 30),
+            Package("pkg_id02", 75, 125),
+            Package("pkg_id03", 175, 100),
+            Package("pkg_id04", 110, 60),
+            Package("pkg_id05", 155, 95)};
+    const std::array<int, 5> volumes = {1, 4, 1, 4, 1};
+    for (size_t i = 0; i < pkgs.size(); i++)
+    {
+        pkgs[i].setVolume(volumes[i]);
+    }
+    const int no_of_vehicles = 2, max_speed = 70, max_carriable_weight = 200;
+    VehicleLimits limits;
+    limits.max_volume = 6;
+    // pkg_id02 and pkg_id04 would be the heaviest pair, but together they take 8 units of volume.
+    Delivery::Delivery_Time(pkgs, no_of_vehicles, max_speed, max_carriable_weight, limits);
+
+    for (size_t i = 0; i < pkgs.size(); i++)
+    {
+        if (pkgs[i].getDeliveryTime() != expected_delivery_time[i])
+        {
+            std::cout << "Test : package_time_computation_with_volume_limit FAILED" << '\n';
+            return;
+        }
+    }
+    std::cout << "Test : package_time_computation_with_volume_limit PASSED" << '\n';
+}
+
+void package_time_computation_with_negative_volumes()
+{
+    std::vector<Package> pkgs =
+        {
+            Package("pkg_id01", 50, 30),
+            Package("pkg_id02", 75, 125),
+            Package("pkg_id03", 175, 100),
+            Package("pkg_id04", 110, 60),
+            Package("pkg_id05", 155, 95)};
+    std::vector<Package> expected(pkgs);
+    const int no_of_vehicles = 2, max_speed = 70, max_carriable_weight = 200;
+    VehicleLimits limits;
+    limits.max_parcels = 2;
+
+    // A negative volume is rejected, so the plan is the one of packages without a volume.
+    bool testFailed = false;
+    for (auto &&pkg : pkgs)
+    {
+        pkg.setVolume(-7);
+        testFailed |= pkg.getVolume() != 0;
+    }
+    Delivery::Delivery_Time(pkgs, no_of_vehicles, max_speed, max_carriable_weight, limits);
+    Delivery::Delivery_Time(expected, no_of_vehicles, max_speed, max_carriable_weight, limits);
+    for (size_t i = 0; i < pkgs.size(); i++)
+    {
+        testFailed |= pkgs[i].getDeliveryTime() != expected[i].getDeliveryTime();
+    }
+
+    if (testFailed)
+    {
+        std::cout << "Test : package_time_computation_with_negative_volumes FAILED" << '\n';
+        return;
+    }
+    std::cout << "Test : package_time_computation_with_negative_volumes PASSED" << '\n';
+}
+
+void package_time_computation_with_mixed_fleet()
+{
+    std::vector<float> expected_delivery_time = {0.75f, 1.78f, 4.98f, 0.85f, 11.31f};
+    std::vector<Package> pkgs =
+        {
+            Package("pkg_id01", 50, 30),
+            Package("pkg_id02", 75, 125),
+            Package("pkg_id03", 175, 100),
+            Package("pkg_id04", 110, 60),
+            Package("pkg_id05", 155, 95)};
+    // The van takes the heaviest pair first, the bike pkg_id01 and then nothing else fits it.
+    const std::vector<Vehicle> fleet = {Vehicle{70, 200, VehicleLimits()}, Vehicle{40, 80, VehicleLimits()}};
+    Delivery::Delivery_Time(pkgs, fleet);
+
+    for (size_t i = 0; i < pkgs.size(); i++)
+    {
+        if (pkgs[i].getDeliveryTime() != expected_delivery_time[i])
+        {
+            std::cout << "Test : package_time_computation_with_mixed_fleet FAILED" << '\n';
+            return;
+        }
+    }
+    std::cout << "Test : package_time_computation_with_mixed_fleet PASSED" << '\n';
+}
+
+void package_time_computation_with_packed_vehicles()
+{
+    std::vector<float> expected_delivery_time = {0.42f, 1.78f, 1.42f, 0.85f, 4.19f};
+    std::vector<Package> pkgs =
+        {
+            Package("pkg_id01", 50, 30),
+            Package("pkg_id02", 100, 125),
+            Package("pkg_id03", 50, 100),
+            Package("pkg_id04", 100, 60),
+            Package("pkg_id05", 175, 95)};
+    const int no_of_vehicles = 2, max_speed = 70, max_carriable_weight = 175;
+    std::stringstream metrics;
+    SelectionOptions options;
+    options.pack_free_vehicles = true;
+    options.metrics = &metrics;
+    Delivery::Delivery_Time(pkgs, no_of_vehicles, max_speed, max_carriable_weight, options);
+
+    // Both vehicles leave at once, the second one with the weights of the first : pkg_id03 and pkg_id04.
+    std::string first, second;
+    std::getline(metrics, first, '\n');
+    std::getline(metrics, second, '\n');
+    bool testFailed = first.find(" : repeat,") != std::string::npos || second.find(" : repeat,") == std::string::npos;
+    for (size_t i = 0; i < pkgs.size(); i++)
+    {
+        testFailed |= pkgs[i].getDeliveryTime() != expected_delivery_time[i];
+    }
+
+    if (testFailed)
+    {
+        std::cout << "Test : package_time_computation_with_packed_vehicles FAILED" << '\n';
+        return;
+    }
+    std::cout << "Test : package_time_computation_with_packed_vehicles PASSED" << '\n';
+}
+
+void package_time_computation_with_grouped_packages()
+{
+    std::vector<float> expected_delivery_time = {0.42f, 1.78f, 1.42f, 4.41f, 4.19f};
+    std::vector<Package> pkgs =
+        {
+            Package("pkg_id01", 50, 30),
+            Package("pkg_id02", 75, 125),
+            Package("pkg_id03", 175, 100),
+            Package("pkg_id04", 110, 60),
+            Package("pkg_id05", 155, 95)};
+    // pkg_id01 and pkg_id02 are one order, they leave first as the only pair that fits and pkg_id04 goes last.
+    pkgs[0].setGroupId("order01");
+    pkgs[1].setGroupId("order01");
+    const int no_of_vehicles = 2, max_speed = 70, max_carriable_weight = 200;
+    Delivery::Delivery_Time(pkgs, no_of_vehicles, max_speed, max_carriable_weight);
+
+    for (size_t i = 0; i < pkgs.size(); i++)
+    {
+        if (pkgs[i].getDeliveryTime() != expected_delivery_time[i])
+        {
+            std::cout << "Test : package_time_computation_with_grouped_packages FAILED" << '\n';
+            return;
+        }
+    }
+    std::cout << "Test : package_time_computation_with_grouped_packages PASSED" << '\n';
+}
+
+void package_time_computation_with_priority_objective()
+{
+    std::vector<float> expected_delivery_time = {3.98f, 1.78f, 4.12f, 0.85f, 1.35f};
+    std::vector<Package> pkgs =
+        {
+            Package("pkg_id01", 50, 30),
+            Package("pkg_id02", 75, 125),
+            Package("pkg_id03", 175, 100),
+            Package("pkg_id04", 110, 60),
+            Package("pkg_id05", 155, 95)};
+    // pkg_id05 is express : alone it outranks any pair of standard parcels and leaves first.
+    pkgs[4].setPriority(3);
+    const int no_of_vehicles = 2, max_speed = 70, max_carriable_weight = 200;
+    SelectionOptions options;
+    options.objective = SelectionObjective::PriorityThenWeight;
+    Delivery::Delivery_Time(pkgs, no_of_vehicles, max_speed, max_carriable_weight, options);
+
+    for (size_t i = 0; i < pkgs.size(); i++)
+    {
+        if (pkgs[i].getDeliveryTime() != expected_delivery_time[i])
+        {
+            std::cout << "Test : package_time_computation_with_priority_objective FAILED" << '\n';
+            return;
+        }
+    }
+    std::cout << "Test : package_time_computation_with_priority_objective PASSED" << '\n';
+}
+
+void package_time_computation_with_large_objective_totals()
+{
+    std::vector<float> expected_delivery_time = {0.14f, 0.14f};
+    std::vector<Package> pkgs =
+        {
+            Package("pkg_id01", 50, 10),
+            Package("pkg_id02", 51, 10)};
+    // Both fit together, but each priority is 2^30 and each cost is above 2^31 cents.
+    const Offer no_offer = {"NA", 0, 0, 0, 0, 0};
+    for (auto &&pkg : pkgs)
+    {
+        pkg.setPriority(1 << 30);
+        pkg.CalculateCost(30000000, no_offer);
+    }
+    const int no_of_vehicles = 1, max_speed = 70, max_carriable_weight = 107;
+
+    for (auto objective : {SelectionObjective::PriorityThenWeight, SelectionObjective::RevenueThenWeight})
+    {
+        SelectionOptions options;
+        options.objective = objective;
+        Delivery::Delivery_Time(pkgs, no_of_vehicles, max_speed, max_carriable_weight, options);
+
+        for (size_t i = 0; i < pkgs.size(); i++)
+        {
+            if (pkgs[i].getDeliveryTime() != expected_delivery_time[i])
+            {
+                std::cout << "Test : package_time_computation_with_large_objective_totals FAILED" << '\n';
+                return;
+            }
+        }
+    }
+    std::cout << "Test : package_time_computation_with_large_objective_totals PASSED" << '\n';
+}
+
+void workflow_integration_test()
+{
+    std::stringstream oss, iss;
+    Delivery::SetUpDelivery("json_files\\offers.json", false, oss);
+    iss << "100 5\nPKG1 50 30 OFR001\nPKG2 75 125 OFFR0008\nPKG3 175 100 OFFR003\nPKG4 110 60 OFFR002\nPKG5 155 95 NA \n2 70 200\n";
+    Delivery::ExecuteWorkflow(oss, iss);
+    std::string output = "";
+    std::array<std::pair<std::string, std::string>, 8> expected_errors =
+        {
+            std::make_pair("PKG1", "PKG1 0.00 750.00 3.98"),
+            std::make_pair("PKG2", "PKG2 0.00 1475.00 1.78"),
+            std::make_pair("PKG3", "PKG3 0.00 2350.00 1.42"),
+            std::make_pair("PKG4", "PKG4 105.00 1395.00 0.85"),
+            std::make_pair("PKG5", "PKG5 0.00 2125.00 4.19")};
+
+    int idx = 0;
+
+    std::cout << "Test : workflow_integration_test : " << '\n';
+    bool testFailed = false;
+
+    while (std::getline(oss, output, '\n'))
+    {
+        if (output.compare(expected_errors[idx].second) != 0)
+        {
+            std::cout << "\t Values for Package Id : " << expected_errors[idx].first << " does not Match" << '\n';
+            testFailed = true;
+        }
+        idx++;
+    }
+    if (testFailed)
+    {
+        std::cout << "\t Test workflow_integration_test : FAILED" << '\n';
+    }
+    else
+    {
+        std::cout << "\t Test workflow_integration_test : PASSED" << '\n';
+    }
+}
+
+void workflow_integration_test_with_weight_tie()
+{
+    std::stringstream oss, iss;
+    Delivery::SetUpDelivery("json_files\\offers.json", false, oss);
+    iss << "100 6\nPKG1 50 30 OFR001\nPKG2 75 125 OFFR0008\nPKG3 175 100 OFFR003\nPKG4 110 60 OFFR002\nPKG5 155 95 NA \nPKG6 60 87 OFFR002 \n3 85 200\n";
+    Delivery::ExecuteWorkflow(oss, iss);
+    std::string output = "";
+    std::array<std::pair<std::string, std::string>, 8> expected_errors =
+        {
+            std::make_pair("PKG1", "PKG1 0.00 750.00 0.35"),
+            std::make_pair("PKG2", "PKG2 0.00 1475.00 1.47"),
+            std::make_pair("PKG3", "PKG3 0.00 2350.00 1.17"),
+            std::make_pair("PKG4", "PKG4 105.00 1395.00 2.92"),
+            std::make_pair("PKG5", "PKG5 0.00 2125.00 1.11"),
+            std::make_pair("PKG6", "PKG6 79.45 1055.55 1.02")
+        };
+
+    int idx = 0;
+
+    std::cout << "Test : workflow_integration_test_with_weight_tie : " << '\n';
+    bool testFailed = false;
+
+    while (std::getline(oss, output, '\n'))
+    {
+        if (output.compare(expected_errors[idx].second) != 0)
+        {
+            std::cout << "\t Values for Package Id : " << expected_errors[idx].first << " does not Match" << '\n';
+            testFailed = true;
+        }
+        idx++;
+    }
+    if (testFailed)
+    {
+        std::cout << "\t Test workflow_integration_test_with_weight_tie : FAILED" << '\n';
+    }
+    else
+    {
+        std::cout << "\t Test workflow_integration_test_with_weight_tie : PASSED" << '\n';
+    }
+}
+
+void workflow_integration_test_with_package_weight_greater_than_max_carriable_weight()
+{
+    std::stringstream oss, iss;
+    Delivery::SetUpDelivery("modular\\json_files\\offers.json", false, oss);
+    iss << "100 6\nPKG1 50 30 OFR001\nPKG2 75 125 OFFR0008\nPKG3 201 100 OFFR003\nPKG4 110 60 OFFR002\nPKG5 155 95 NA \nPKG6 60 87 OFFR002 \n3 85 200\n";
+    Delivery::ExecuteWorkflow(iss, oss);
+    std::string output = "";
+    std::array<std::pair<std::string, std::string>, 8> expected_errors =
+        {
+            std::make_pair("PKG1", "PKG1 0.00 750.00 0.35"),
+            std::make_pair("PKG2", "PKG2 0.00 1475.00 1.47"),
+            std::make_pair("PKG3", "PKG3 0.00 2350.00 1.17"),
+            std::make_pair("PKG4", "PKG4 105.00 1395.00 2.92"),
+            std::make_pair("PKG5", "PKG5 0.00 2125.00 1.11"),
+            std::make_pair("PKG6", "PKG6 79.45 1055.55 1.02")};
+
+    int idx = 0;
+
+    std::cout << "Test : workflow_integration_test_with_package_weight_greater_than_max_carriable_weight : " << '\n';
+    bool testFailed = false;
+
+    while (std::getline(oss, output, '\n'))
+    {
+        if (output.compare(expected_errors[idx].second) != 0)
+        {
+            std::cout << "\t Values for Package Id : " << expected_errors[idx].first << " does not Match Expected : " << expected_errors[idx].second << ", Actual : " << output << '\n';
+            testFailed = true;
+        }
+        else
+        {
+            testFailed = false;
+        }
+        idx++;
+    }
+    if (testFailed)
+    {
+        std::cout << "\t Test workflow_integration_test_with_package_weight_greater_than_max_carriable_weight : FAILED" << '\n';
+    }
+    else
+    {
+        std::cout << "\t Test workflow_integration_test_with_package_weight_greater_than_max_carriable_weight : PASSED" << '\n';
+    }
+}
+
+void workflow_integration_test_with_grouped_packages()
+{
+    std::stringstream oss, iss;
+    // PKG1 carries its group without a volume, PKG2 after one, both read as the same order.
+    iss << "100 5\nPKG1 50 30 NA order01\nPKG2 75 125 NA 4 order01\nPKG3 175 100 NA\nPKG4 110 60 NA\nPKG5 155 95 NA \n2 70 200\n";
+    Delivery::ExecuteWorkflow(iss, oss);
+    std::string output = "";
+    std::array<std::pair<std::string, std::string>, 5> expected_errors =
+        {
+            std::make_pair("PKG1", "PKG1 0.00 750.00 0.42"),
+            std::make_pair("PKG2", "PKG2 0.00 1475.00 1.78"),
+            std::make_pair("PKG3", "PKG3 0.00 2350.00 1.42"),
+            std::make_pair("PKG4", "PKG4 0.00 1500.00 4.41"),
+            std::make_pair("PKG5", "PKG5 0.00 2125.00 4.19")};
+
+    size_t idx = 0;
+
+    std::cout << "Test : workflow_integration_test_with_grouped_packages : " << '\n';
+    bool testFailed = false;
+
+    while (std::getline(oss, output, '\n') && idx < expected_errors.size())
+    {
+        if (output.compare(expected_errors[idx].second) != 0)
+        {
+            std::cout << "\t Values for Package Id : " << expected_errors[idx].first << " does not Match Expected : " << expected_errors[idx].second << ", Actual : " << output << '\n';
+            testFailed = true;
+        }
+        idx++;
+    }
+    if (testFailed || idx != expected_errors.size())
+    {
+        std::cout << "\t Test workflow_integration_test_with_grouped_packages : FAILED" << '\n';
+    }
+    else
+    {
+        std::cout << "\t Test workflow_integration_test_with_grouped_packages : PASSED" << '\n';
+    }
+}
+
+void workflow_integration_test_with_short_package_line()
+{
+    std::stringstream oss, iss;
+    Delivery::SetUpDelivery("json_files\\offers.json", false, oss);
+    oss.str("");
+    // PKG2 has neither a distance nor an offer, it must not take OFR001 from PKG1.
+    iss << "100 2\nPKG1 100 100 OFR001\nPKG2 75\n1 70 200\n";
+    Delivery::ExecuteWorkflow(iss, oss);
+    std::string output = "";
+    std::array<std::pair<std::string, std::string>, 2> expected_errors =
+        {
+            std::make_pair("PKG1", "PKG1 160.00 1440.00 1.42"),
+            std::make_pair("PKG2", "PKG2 0.00 850.00 0.00")};
+
+    size_t idx = 0;
+
+    std::cout << "Test : workflow_integration_test_with_short_package_line : " << '\n';
+    bool testFailed = false;
+
+    while (std::getline(oss, output, '\n') && idx < expected_errors.size())
+    {
+        if (output.compare(expected_errors[idx].second) != 0)
+        {
+            std::cout << "\t Values for Package Id : " << expected_errors[idx].first << " does not Match Expected : " << expected_errors[idx].second << ", Actual : " << output << '\n';
+            testFailed = true;
+        }
+        idx++;
+    }
+    if (testFailed || idx != expected_errors.size())
+    {
+        std::cout << "\t Test workflow_integration_test_with_short_package_line : FAILED" << '\n';
+    }
+    else
+    {
+        std::cout << "\t Test workflow_integration_test_with_short_package_line : PASSED" << '\n';
     }
 }
 
@@ -370,7 +1467,40 @@ int main()
     package_cost_computation_with_different_distance_multiplier();
     package_time_computation();
     package_time_computation_with_weight_tie();
+    package_time_computation_with_bitset_engine();
+    kp_kernel_matches_the_scalar_sweep();
+    shipment_selection_with_compressed_capacity();
+    shipment_selection_with_weight_classes();
+    shipment_selection_with_exhausted_time_budget();
+    shipment_selection_with_parallel_sweep();
+    package_time_computation_with_concurrent_parallel_sweeps();
+    shipment_selection_with_tiled_sweep();
+    shipment_selection_with_decision_budget();
+    shipment_selection_with_fixed_capacities();
+    shipment_selection_with_count_first_engine();
+    shipment_selection_with_sparse_engine();
+    shipment_selection_with_meet_in_the_middle_engine();
+    shipment_selection_with_approximate_engine();
+    planning_arena_reuses_its_block_after_release();
+    planning_arena_copies_into_the_current_arena();
+    waiting_packages_keep_the_plan_arena_bounded();
+    waiting_packages_prune_candidates_without_changing_the_bag();
+    items_scanned_per_round_ignore_shipped_packages();
+    items_scanned_per_round_of_concurrent_plans();
+    package_time_computation_without_trivial_rounds();
+    shipment_cache_replays_a_repeated_plan();
+    shipment_cache_keeps_the_largest_requested_size();
+    shipment_selection_reports_its_engine();
+    package_time_computation_with_volume_limit();
+    package_time_computation_with_negative_volumes();
+    package_time_computation_with_mixed_fleet();
+    package_time_computation_with_packed_vehicles();
+    package_time_computation_with_grouped_packages();
+    package_time_computation_with_priority_objective();
+    package_time_computation_with_large_objective_totals();
     workflow_integration_test();
     workflow_integration_test_with_weight_tie();
     workflow_integration_test_with_package_weight_greater_than_max_carriable_weight();
+    workflow_integration_test_with_grouped_packages();
+    workflow_integration_test_with_short_package_line();
 }
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include <memory>
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(size_t no_of_threads)
+{
+    for (size_t i = 1; i < no_of_threads; i++)
+    {
+        workers.emplace_back(&ThreadPool::work, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (auto &&worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::work(size_t thread_id)
+{
+    size_t seen = 0;
+
+    while (true)
+    {
+        std::function<void(size_t)> job;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            wake.wait(guard, [this, seen]
+                      { return stopping || generation != seen; });
+            if (stopping)
+            {
+                return;
+            }
+            seen = generation;
+            job = task;
+        }
+
+        job(thread_id);
+
+        std::lock_guard<std::mutex> guard(lock);
+        if (--running == 0)
+        {
+            finished.notify_one();
+        }
+    }
+}
+
+void ThreadPool::Run(const std::function<void(size_t)> &job)
+{
+    if (workers.empty())
+    {
+        job(0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        task = job;
+        running = workers.size();
+        generation++;
+    }
+    wake.notify_all();
+
+    job(0);
+
+    std::unique_lock<std::mutex> guard(lock);
+    finished.wait(guard, [this]
+                  { return running == 0; });
+}
+
+ThreadPool &SharedThreadPool(size_t no_of_threads)
+{
+    // Run serves one caller at a time, so every planning thread keeps a pool of its own.
+    static thread_local std::unique_ptr<ThreadPool> pool;
+
+    if (!pool || pool->size() != no_of_threads)
+    {
+        pool.reset();
+        pool.reset(new ThreadPool(no_of_threads));
+    }
+    return *pool;
+}
+
+void SpinBarrier::Wait()
+{
+    const size_t current = phase.load(std::memory_order_acquire);
+
+    if (arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == parties)
+    {
+        arrived.store(0, std::memory_order_relaxed);
+        phase.store(current + 1, std::memory_order_release);
+        return;
+    }
+
+    for (unsigned spins = 0; phase.load(std::memory_order_acquire) == current; spins++)
+    {
+        if (spins >= 64)
+        {
+            std::this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads that run one task on every thread at once. The calling thread takes part as
+// thread 0, so a pool of size 1 has no workers and runs the task inline.
+class ThreadPool
+{
+    std::vector<std::thread> workers;
+    std::mutex lock;
+    std::condition_variable wake, finished;
+    std::function<void(size_t)> task;
+    size_t generation = 0, running = 0;
+    bool stopping = false;
+
+    void work(size_t thread_id);
+
+public:
+    explicit ThreadPool(size_t no_of_threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    size_t size() const { return workers.size() + 1; }
+
+    // Calls job(0) .. job(size() - 1), one per thread, and returns once all of them are done. Not reentrant, only
+    // one thread may call Run on a pool.
+    void Run(const std::function<void(size_t)> &job);
+};
+
+// Pool shared by every kp sweep of the calling thread, rebuilt only when a different thread count is asked for.
+// Plans running on different threads never share a pool.
+ThreadPool &SharedThreadPool(size_t no_of_threads);
+
+// Barrier for the threads of one ThreadPool::Run. Waiting spins briefly and then yields, since the phases it
+// separates are short.
+class SpinBarrier
+{
+    const size_t parties;
+    std::atomic<size_t> arrived{0}, phase{0};
+
+public:
+    explicit SpinBarrier(size_t parties) : parties(parties) {}
+
+    void Wait();
+};
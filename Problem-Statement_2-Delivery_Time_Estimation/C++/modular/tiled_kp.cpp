@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <chrono>
+#include "kp_kernel.h"
+#include "tiled_kp.h"
+
+namespace
+{
+    // Cells every package of a tile relaxes per pass, the rest of the block is the lag between the packages.
+    int stepCells(int block_cells) { return block_cells / 8; }
+
+    int tuneBlockCells()
+    {
+        const int capacity = 1 << 20;
+        SelectionItems items;
+        unsigned seed = 7;
+        for (size_t i = 0; i < 8; i++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            items.push_back({i, static_cast<int>(64 + (seed >> 8) % 2048), 0, 0});
+        }
+
+        const size_t words_per_item = (static_cast<size_t>(capacity) >> 6) + 1;
+        std::vector<uint64_t> scores(capacity + 1), decisions(items.size() * words_per_item);
+
+        int best_cells = 0;
+        auto best_time = std::chrono::steady_clock::duration::max();
+        for (int block_cells = 1 << 15; block_cells <= 1 << 18; block_cells <<= 1)
+        {
+            // Best of two runs, a single one is easily skewed by the first touch of the rows.
+            for (int run = 0; run < 2; run++)
+            {
+                std::fill(scores.begin(), scores.end(), 0);
+                auto start = std::chrono::steady_clock::now();
+                TiledRelaxScores(items, capacity, scores.data(), decisions.data(), words_per_item, block_cells);
+                auto elapsed = std::chrono::steady_clock::now() - start;
+
+                if (elapsed < best_time)
+                {
+                    best_time = elapsed;
+                    best_cells = block_cells;
+                }
+            }
+        }
+        return best_cells;
+    }
+}
+
+int TiledBlockCells()
+{
+    static const int block_cells = tuneBlockCells();
+    return block_cells;
+}
+
+void TiledRelaxScores(const SelectionItems &items, int capacity, uint64_t *scores,
+                      uint64_t *decisions, size_t words_per_item, int block_cells)
+{
+    const int step = stepCells(block_cells);
+    ArenaVector<int> lag;
+
+    for (size_t first = 0, last; first < items.size(); first = last)
+    {
+        lag.assign(1, 0);
+        for (last = first + 1; last < items.size() && lag.back() + items[last].weight + step <= block_cells; last++)
+        {
+            lag.push_back(lag.back() + items[last].weight);
+        }
+
+        std::fill(decisions + first * words_per_item, decisions + last * words_per_item, 0);
+
+        if (last - first == 1)
+        {
+            RelaxScores(scores, decisions + first * words_per_item, capacity, items[first].weight);
+            continue;
+        }
+
+        for (int top = capacity; top + lag.back() >= 0; top -= step)
+        {
+            for (size_t i = first; i < last; i++)
+            {
+                const int low = top + lag[i - first] - step + 1;
+                if (low <= capacity)
+                {
+                    RelaxScoresRange(scores, decisions + i * words_per_item, low, std::min(capacity, low + step - 1), items[i].weight);
+                }
+            }
+        }
+    }
+}
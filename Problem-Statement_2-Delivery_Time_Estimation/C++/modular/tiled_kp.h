@@ -0,0 +1,18 @@
+#pragma once
+
+#include "selection.h"
+
+// Rows at least this wide (64 MB of scores) are tiled, below it the plain per-package sweep of Delivery::kp is kept.
+// benchmark.cpp only measures a gain on rows far past the last level cache, an 8 MB row ran the same either way.
+const int kTiledMinCapacity = 1 << 23;
+
+// Capacities a tiled sweep keeps hot at once. Timed on a synthetic row the first time it is asked for.
+int TiledBlockCells();
+
+// The sweep of Delivery::kp, relaxing several packages per pass over a block of capacities instead of streaming the
+// whole row once per package. Package k of a tile trails package k - 1 by its own weight, so when it relaxes a cell,
+// the cell and the one it reads below have already been relaxed by every earlier package of the tile and by no
+// later one. A tile takes packages while the distance from the first to the last plus one step fits in block_cells.
+// scores and the decision rows end up exactly as one RelaxScores call per package leaves them.
+void TiledRelaxScores(const SelectionItems &items, int capacity, uint64_t *scores,
+                      uint64_t *decisions, size_t words_per_item, int block_cells);
@@ -0,0 +1,265 @@
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include "two_constraint_selector.h"
+
+namespace
+{
+    const int kNoVolume = std::numeric_limits<int>::max();
+    const double kVolumeTableBytes = 64.0 * (1 << 20);
+
+    struct limitedState
+    {
+        int weight;
+        int count;
+        int volume;
+    };
+
+    bool byWeightAndCount(const limitedState &lhs, const limitedState &rhs)
+    {
+        return lhs.weight < rhs.weight || (lhs.weight == rhs.weight && lhs.count < rhs.count);
+    }
+
+    // Least volume among the states kept so far with more than a given count : a Fenwick tree of minimums over
+    // the counts in reverse, cleared after every package by resetting only the entries it wrote.
+    class leastVolumeAbove
+    {
+        ArenaVector<int> tree;
+        ArenaVector<size_t> written;
+        int max_count;
+
+    public:
+        explicit leastVolumeAbove(int max_count) : tree(max_count + 2, kNoVolume), max_count(max_count) {}
+
+        void Insert(int count, int volume)
+        {
+            for (size_t i = max_count - count + 1; i < tree.size(); i += i & (0 - i))
+            {
+                if (volume < tree[i])
+                {
+                    if (tree[i] == kNoVolume)
+                    {
+                        written.push_back(i);
+                    }
+                    tree[i] = volume;
+                }
+            }
+        }
+
+        int Query(int count) const
+        {
+            int least = kNoVolume;
+            for (size_t i = max_count - count; i > 0; i -= i & (0 - i))
+            {
+                least = std::min(least, tree[i]);
+            }
+            return least;
+        }
+
+        void Clear()
+        {
+            for (auto &&i : written)
+            {
+                tree[i] = kNoVolume;
+            }
+            written.clear();
+        }
+    };
+
+    void selectByFrontier(const SelectionItems &items, int max_carriable_weight, int max_volume, int max_parcels,
+                          ArenaVector<size_t> &bag)
+    {
+        const bool fuller_dominates = max_parcels == static_cast<int>(items.size());
+
+        ArenaVector<limitedState> frontier(1, limitedState{0, 0, 0}), shifted, merged;
+        ArenaVector<char> added, kept;
+        leastVolumeAbove fuller(max_parcels);
+
+        // created[created_from[p] .. created_from[p + 1]) holds the states package p added to the frontier, by weight.
+        ArenaVector<limitedState> created;
+        ArenaVector<size_t> created_from(1, 0);
+
+        for (size_t p = 0; p < items.size(); p++)
+        {
+            const SelectionItem &item = items[p];
+            shifted.clear();
+            for (auto &&state : frontier)
+            {
+                if (state.weight <= max_carriable_weight - item.weight && state.count < max_parcels &&
+                    state.volume <= max_volume - item.volume)
+                {
+                    shifted.push_back(limitedState{state.weight + item.weight, state.count + 1, state.volume + item.volume});
+                }
+            }
+
+            // Both lists are sorted by (weight, count). A pair reached both ways keeps its least volume, the old state
+            // on a tie.
+            merged.clear();
+            added.clear();
+            size_t a = 0, b = 0;
+            while (a < frontier.size() || b < shifted.size())
+            {
+                if (b == shifted.size() || (a < frontier.size() && byWeightAndCount(frontier[a], shifted[b])))
+                {
+                    merged.push_back(frontier[a++]);
+                    added.push_back(0);
+                }
+                else if (a == frontier.size() || byWeightAndCount(shifted[b], frontier[a]))
+                {
+                    merged.push_back(shifted[b++]);
+                    added.push_back(1);
+                }
+                else
+                {
+                    const bool smaller = shifted[b].volume < frontier[a].volume;
+                    merged.push_back(smaller ? shifted[b] : frontier[a]);
+                    added.push_back(smaller);
+                    a++;
+                    b++;
+                }
+            }
+
+            kept.assign(merged.size(), 1);
+
+            // Within a weight the fuller states are visited first, so every state meets all the lighter or equally
+            // heavy ones with more packages before it.
+            if (fuller_dominates)
+            {
+                for (size_t first = 0, last = 0; first < merged.size(); first = last)
+                {
+                    while (last < merged.size() && merged[last].weight == merged[first].weight)
+                    {
+                        last++;
+                    }
+                    for (size_t i = last; i-- > first;)
+                    {
+                        kept[i] = kept[i] && fuller.Query(merged[i].count) > merged[i].volume;
+                        if (kept[i])
+                        {
+                            fuller.Insert(merged[i].count, merged[i].volume);
+                        }
+                    }
+                }
+                fuller.Clear();
+            }
+
+            frontier.clear();
+            for (size_t i = 0; i < merged.size(); i++)
+            {
+                if (kept[i])
+                {
+                    frontier.push_back(merged[i]);
+                    if (added[i])
+                    {
+                        created.push_back(merged[i]);
+                    }
+                }
+            }
+            created_from.push_back(created.size());
+        }
+
+        bag.clear();
+        limitedState target = *std::max_element(frontier.begin(), frontier.end(),
+                                                [](const limitedState &lhs, const limitedState &rhs)
+                                                {
+                                                    return lhs.count < rhs.count || (lhs.count == rhs.count && lhs.weight < rhs.weight);
+                                                });
+
+        for (size_t p = items.size(); p-- > 0 && target.count > 0;)
+        {
+            auto first = created.begin() + created_from[p], last = created.begin() + created_from[p + 1];
+            auto found = std::lower_bound(first, last, target, byWeightAndCount);
+
+            if (found != last && found->weight == target.weight && found->count == target.count &&
+                found->volume == target.volume)
+            {
+                bag.push_back(items[p].idx);
+                target = limitedState{target.weight - items[p].weight, target.count - 1, target.volume - items[p].volume};
+            }
+        }
+    }
+
+    // least[c][w] is the least volume of c packages weighing exactly w, one decision bit per package and cell.
+    // Level c only starts at the weight of the c lightest packages, lighter cells are never reached.
+    void selectByVolumeTable(const SelectionItems &items, int max_carriable_weight, int max_volume, int max_count,
+                             ArenaVector<size_t> &bag)
+    {
+        const size_t columns = static_cast<size_t>(max_carriable_weight) + 1;
+        const size_t words_per_item = ((max_count + 1) * columns + 63) >> 6;
+        const ArenaVector<long long> lightest_sums = LightestWeightSums(items);
+
+        std::vector<int> least((max_count + 1) * columns, kNoVolume);
+        std::vector<uint64_t> decisions(items.size() * words_per_item, 0);
+        least[0] = 0;
+
+        for (size_t p = 0; p < items.size(); p++)
+        {
+            const int weight = items[p].weight, volume = items[p].volume;
+            uint64_t *row = decisions.data() + p * words_per_item;
+
+            for (int c = static_cast<int>(std::min<size_t>(max_count, p + 1)); c > 0; c--)
+            {
+                const int *from = least.data() + (c - 1) * columns;
+                int *to = least.data() + c * columns;
+                const long long lowest = std::max<long long>(weight, lightest_sums[c - 1] + weight);
+
+                for (long long w = max_carriable_weight; w >= lowest; w--)
+                {
+                    const int reached = from[w - weight];
+                    if (reached != kNoVolume && reached <= max_volume - volume && reached + volume < to[w])
+                    {
+                        to[w] = reached + volume;
+                        const size_t bit = c * columns + w;
+                        row[bit >> 6] |= uint64_t{1} << (bit & 63);
+                    }
+                }
+            }
+        }
+
+        bag.clear();
+        int count = max_count, weight = max_carriable_weight;
+        while (count > 0)
+        {
+            weight = max_carriable_weight;
+            while (weight >= 0 && least[count * columns + weight] == kNoVolume)
+            {
+                weight--;
+            }
+            if (weight >= 0)
+            {
+                break;
+            }
+            count--;
+        }
+
+        for (size_t p = items.size(); p-- > 0 && count > 0;)
+        {
+            const size_t bit = count * columns + weight;
+            if ((decisions[p * words_per_item + (bit >> 6)] >> (bit & 63)) & 1)
+            {
+                bag.push_back(items[p].idx);
+                count--;
+                weight -= items[p].weight;
+            }
+        }
+    }
+}
+
+void SelectWithVehicleLimits(const SelectionItems &items, int max_carriable_weight, const VehicleLimits &limits,
+                             ArenaVector<size_t> &bag)
+{
+    const int max_volume = limits.max_volume > 0 ? limits.max_volume : kNoVolume;
+    const int no_of_items = static_cast<int>(items.size());
+    const int max_parcels = limits.max_parcels > 0 ? std::min(limits.max_parcels, no_of_items) : no_of_items;
+    const int max_count = std::min(max_parcels, MaxShipmentCount(items, max_carriable_weight));
+
+    const double table_bytes = (max_count + 1.0) * (max_carriable_weight + 1.0) * (items.size() / 8.0 + sizeof(int));
+    if (table_bytes <= kVolumeTableBytes)
+    {
+        selectByVolumeTable(items, max_carriable_weight, max_volume, max_count, bag);
+    }
+    else
+    {
+        selectByFrontier(items, max_carriable_weight, max_volume, max_parcels, bag);
+    }
+}
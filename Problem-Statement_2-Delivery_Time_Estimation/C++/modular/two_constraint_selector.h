@@ -0,0 +1,19 @@
+#pragma once
+
+#include "selection.h"
+
+// Selection under a volume limit and/or a parcel limit on top of max_carriable_weight, still taking the most
+// packages and then the most weight. Neither way keeps a table over every (weight, volume) pair : for a given
+// package count and weight only the least volume matters, any other state with the same count and weight is
+// dominated by it.
+// - While the decision bits fit in 64 MB, a dense table of least volumes per (count, weight) is swept like kp,
+//   count by count, each count starting at the weight of that many of the lightest packages.
+// - Otherwise (weights in grams) the frontier of reachable (weight, count, volume) states is kept sorted by weight
+//   and count. Without a parcel limit a state is also dropped once a state no heavier and no bulkier holds more
+//   packages, since any completion of it fits the other one too and ships more. With a parcel limit the fuller
+//   state may no longer take the whole completion, so only the first rule applies. The bag is rebuilt from the
+//   last package down like in the sparse engine.
+// The bag is listed from the highest index down.
+void SelectWithVehicleLimits(const SelectionItems &items, int max_carriable_weight, const VehicleLimits &limits,
+                             ArenaVector<size_t> &bag);
+
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "selection.h"
+
+// One vehicle of the fleet : how fast it drives, how much weight it carries and what else limits its load.
+struct Vehicle
+{
+    int max_speed;
+    int max_carriable_weight;
+    VehicleLimits limits;
+};
@@ -0,0 +1,291 @@
+#include <algorithm>
+#include <limits>
+#include <functional>
+#include "package.h"
+#include "waiting_packages.h"
+
+namespace
+{
+    const size_t kNotWaiting = std::numeric_limits<size_t>::max();
+
+    void sortByIndex(SelectionItems &items)
+    {
+        std::sort(items.begin(), items.end(),
+                  [](const SelectionItem &lhs, const SelectionItem &rhs)
+                  {
+                      return lhs.idx < rhs.idx;
+                  });
+    }
+}
+
+WaitingPackages::WaitingPackages(std::vector<Package> &packages, int max_carriable_weight, const VehicleLimits &limits)
+    : WaitingPackages(packages, std::vector<Vehicle>(1, Vehicle{0, max_carriable_weight, limits}))
+{
+}
+
+WaitingPackages::WaitingPackages(std::vector<Package> &packages, const std::vector<Vehicle> &fleet)
+    : slot(packages.size(), kNotWaiting), class_of(packages.size(), kNotWaiting)
+{
+    for (size_t i = 0; i < packages.size(); i++)
+    {
+        const bool fits = std::any_of(fleet.begin(), fleet.end(),
+                                      [&packages, i](const Vehicle &vehicle)
+                                      {
+                                          const int volume_limit = vehicle.limits.max_volume;
+                                          return packages[i].getWeight() <= vehicle.max_carriable_weight &&
+                                                 (volume_limit <= 0 || packages[i].getVolume() <= volume_limit);
+                                      });
+        if (packages[i].getWeight() >= 0 && packages[i].getVolume() >= 0 && fits)
+        {
+            slot[i] = active.size();
+            active.push_back(SelectionItem{i, packages[i].getWeight(), packages[i].getDistance(), packages[i].getVolume()});
+            total_weight += packages[i].getWeight();
+        }
+    }
+
+    by_weight = active;
+    std::sort(by_weight.begin(), by_weight.end(),
+              [](const SelectionItem &lhs, const SelectionItem &rhs)
+              {
+                  return lhs.weight < rhs.weight || (lhs.weight == rhs.weight && lhs.idx < rhs.idx);
+              });
+
+    for (size_t i = 0; i < by_weight.size(); i++)
+    {
+        if (i == 0 || by_weight[i].weight != by_weight[i - 1].weight)
+        {
+            classes.push_back(weightClass{i, i});
+        }
+        classes.back().last = i + 1;
+        class_of[by_weight[i].idx] = classes.size() - 1;
+    }
+
+    occupied.assign((classes.size() + 63) >> 6, 0);
+    for (size_t c = 0; c < classes.size(); c++)
+    {
+        occupied[c >> 6] |= uint64_t{1} << (c & 63);
+    }
+}
+
+size_t WaitingPackages::nextClass(size_t from) const
+{
+    size_t word = from >> 6;
+    if (word >= occupied.size())
+    {
+        return classes.size();
+    }
+
+    uint64_t bits = occupied[word] & (~uint64_t{0} << (from & 63));
+    while (bits == 0)
+    {
+        if (++word == occupied.size())
+        {
+            return classes.size();
+        }
+        bits = occupied[word];
+    }
+    return (word << 6) + CountTrailingZeros(bits);
+}
+
+SelectionItems WaitingPackages::Candidates(int max_carriable_weight) const
+{
+    // Largest shipment count, taking the lightest packages first.
+    long long load = 0;
+    size_t max_count = 0;
+
+    for (size_t c = nextClass(0); c < classes.size(); c = nextClass(c + 1))
+    {
+        const size_t waiting = classes[c].last - classes[c].first;
+        const int weight = by_weight[classes[c].first].weight;
+        size_t fit = weight == 0 ? waiting : std::min<long long>(waiting, (max_carriable_weight - load) / weight);
+
+        scanned++;
+        max_count += fit;
+        load += static_cast<long long>(fit) * weight;
+        if (fit < waiting)
+        {
+            break;
+        }
+    }
+
+    SelectionItems items;
+    for (size_t c = nextClass(0); c < classes.size(); c = nextClass(c + 1))
+    {
+        const int weight = by_weight[classes[c].first].weight;
+        size_t take = std::min(classes[c].last - classes[c].first, max_count);
+        if (weight > 0)
+        {
+            take = std::min<size_t>(take, max_carriable_weight / weight);
+        }
+
+        scanned += take;
+        items.insert(items.end(), by_weight.begin() + classes[c].first, by_weight.begin() + classes[c].first + take);
+    }
+
+    sortByIndex(items);
+    return items;
+}
+
+SelectionItems WaitingPackages::All() const
+{
+    SelectionItems items(active.begin(), active.end());
+
+    scanned += items.size();
+    sortByIndex(items);
+    return items;
+}
+
+bool WaitingPackages::TrivialShipment(int max_carriable_weight, bool lightest_first, ArenaVector<size_t> &bag) const
+{
+    bag.clear();
+    if ((active.size() == 1 && active[0].weight <= max_carriable_weight) || total_weight <= max_carriable_weight)
+    {
+        scanned += active.size();
+        for (auto &&item : active)
+        {
+            bag.push_back(item.idx);
+        }
+        std::sort(bag.begin(), bag.end(), std::greater<size_t>());
+        return true;
+    }
+    if (!lightest_first)
+    {
+        return false;
+    }
+
+    // Takes whole classes, lightest first, up to the one that no longer fits entirely.
+    long long load = 0;
+    size_t c = nextClass(0), previous = classes.size(), fit = 0;
+    for (; c < classes.size(); previous = c, c = nextClass(c + 1))
+    {
+        const size_t waiting = classes[c].last - classes[c].first;
+        const int weight = by_weight[classes[c].first].weight;
+        fit = weight == 0 ? waiting : std::min<long long>(waiting, (max_carriable_weight - load) / weight);
+
+        scanned++;
+        load += static_cast<long long>(fit) * weight;
+        if (fit < waiting)
+        {
+            break;
+        }
+    }
+
+    // Any other k packages either hold one heavier than the heaviest taken, v, and weigh at least load - v plus
+    // that, or swap a lighter taken package for a waiting one of weight v and weigh at least load - lighter + v.
+    const auto weight_of = [this](size_t cls)
+    {
+        return static_cast<long long>(by_weight[classes[cls].first].weight);
+    };
+    if (previous == classes.size() && fit == 0)
+    {
+        // Not even the lightest package fits this vehicle.
+        return true;
+    }
+    if (fit > 0)
+    {
+        const size_t next = nextClass(c + 1);
+        if ((next < classes.size() && load - weight_of(c) + weight_of(next) <= max_carriable_weight) ||
+            (previous < classes.size() && load - weight_of(previous) + weight_of(c) <= max_carriable_weight))
+        {
+            return false;
+        }
+    }
+    else if (load - weight_of(previous) + weight_of(c) <= max_carriable_weight)
+    {
+        return false;
+    }
+
+    for (size_t taken = nextClass(0); taken <= c && taken < classes.size(); taken = nextClass(taken + 1))
+    {
+        const size_t take = taken == c ? fit : classes[taken].last - classes[taken].first;
+        for (size_t i = classes[taken].first; i < classes[taken].first + take; i++)
+        {
+            bag.push_back(by_weight[i].idx);
+        }
+        scanned += take;
+    }
+    std::sort(bag.begin(), bag.end(), std::greater<size_t>());
+    return true;
+}
+
+bool WaitingPackages::RepeatShipment(const ArenaVector<size_t> &shipped, ArenaVector<size_t> &bag) const
+{
+    bag.clear();
+    ArenaVector<size_t> shipped_classes;
+    for (auto &&idx : shipped)
+    {
+        if (idx >= class_of.size() || class_of[idx] == kNotWaiting)
+        {
+            return false;
+        }
+        shipped_classes.push_back(class_of[idx]);
+    }
+    std::sort(shipped_classes.begin(), shipped_classes.end());
+
+    for (size_t first = 0, last = 0; first < shipped_classes.size(); first = last)
+    {
+        while (last < shipped_classes.size() && shipped_classes[last] == shipped_classes[first])
+        {
+            last++;
+        }
+        const weightClass &range = classes[shipped_classes[first]];
+        if (range.last - range.first < last - first)
+        {
+            return false;
+        }
+        for (size_t i = range.first; i < range.first + (last - first); i++)
+        {
+            bag.push_back(by_weight[i].idx);
+        }
+        scanned += last - first;
+    }
+    std::sort(bag.begin(), bag.end(), std::greater<size_t>());
+    return !bag.empty();
+}
+
+void WaitingPackages::Remove(const ArenaVector<size_t> &shipped)
+{
+    // Engines hand back their bags in any order, the lowest indices go first so each one leaves from a class front.
+    ArenaVector<size_t> ordered(shipped);
+    std::sort(ordered.begin(), ordered.end());
+
+    for (auto &&idx : ordered)
+    {
+        if (idx >= slot.size() || slot[idx] == kNotWaiting)
+        {
+            continue;
+        }
+
+        const size_t position = slot[idx];
+        total_weight -= active[position].weight;
+        active[position] = active.back();
+        slot[active[position].idx] = position;
+        active.pop_back();
+        slot[idx] = kNotWaiting;
+
+        // The canonical bag ships the first packages of a class, other engines may take one further in.
+        const size_t c = class_of[idx];
+        auto &range = classes[c];
+        if (by_weight[range.first].idx == idx)
+        {
+            range.first++;
+            scanned++;
+        }
+        else
+        {
+            auto item = std::lower_bound(by_weight.begin() + range.first, by_weight.begin() + range.last, idx,
+                                         [](const SelectionItem &waiting, size_t value)
+                                         {
+                                             return waiting.idx < value;
+                                         });
+            scanned += by_weight.begin() + range.last - item;
+            std::move(item + 1, by_weight.begin() + range.last, item);
+            range.last--;
+        }
+
+        if (range.first == range.last)
+        {
+            occupied[c >> 6] &= ~(uint64_t{1} << (c & 63));
+        }
+    }
+}
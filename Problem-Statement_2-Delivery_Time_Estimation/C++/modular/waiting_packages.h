@@ -0,0 +1,66 @@
+#pragma once
+
+#include "selection.h"
+#include "vehicle.h"
+
+class Package;
+
+// Packages still waiting for a vehicle.
+// kp always ships the lowest indices of every weight it uses : swapping a shipped package for a waiting one of the
+// same weight and a lower index keeps the score and gives a bag kp prefers. So a round only has to look at the
+// first packages of each weight, no more than fit in one vehicle and no more than the largest shipment count.
+// The packages are laid out once by weight and then index, every weight class owns a slice of that array and
+// shipping its first package just moves the start of the slice. A bitmask of the classes still holding packages
+// is walked with count trailing zeros, so a round never visits a weight or a package that is already gone.
+// Every waiting package is also kept in a dense, swap-removed array for the engines that need all of them.
+class WaitingPackages
+{
+    struct weightClass
+    {
+        size_t first;
+        size_t last;
+    };
+
+    SelectionItems by_weight;
+    ArenaVector<weightClass> classes;
+    ArenaVector<uint64_t> occupied;
+    SelectionItems active;
+    ArenaVector<size_t> slot;
+    ArenaVector<size_t> class_of;
+    long long total_weight = 0;
+    mutable size_t scanned = 0;
+
+    size_t nextClass(size_t from) const;
+
+public:
+    // Queues every package of weight 0..max_carriable_weight, and of volume 0..limits.max_volume when that is set.
+    // Other packages can never be shipped.
+    WaitingPackages(std::vector<Package> &packages, int max_carriable_weight, const VehicleLimits &limits = VehicleLimits());
+
+    // Queues every package at least one vehicle of the fleet can take.
+    WaitingPackages(std::vector<Package> &packages, const std::vector<Vehicle> &fleet);
+
+    size_t size() const { return active.size(); }
+
+    // The packages a kp bag can be drawn from in the next round, sorted by index.
+    SelectionItems Candidates(int max_carriable_weight) const;
+
+    // Every waiting package, sorted by index.
+    SelectionItems All() const;
+
+    // Fills bag, listed from the highest index down, when a round needs no engine : only one package waits and fits
+    // or everything waiting fits. With lightest_first it also does when the k lightest packages fit, k + 1 do not and
+    // no swap for a heavier package fits either. The k lightest are then the only best weight and the lowest
+    // indices of every weight in them are the bag kp returns.
+    bool TrivialShipment(int max_carriable_weight, bool lightest_first, ArenaVector<size_t> &bag) const;
+
+    // Fills bag, listed from the highest index down, with the first waiting packages of the weights of shipped, a bag
+    // that already left. Returns false when a weight has too few packages left. When shipped was a best shipment of
+    // the packages waiting then, so is bag : the packages waiting now are fewer and bag weighs the same.
+    bool RepeatShipment(const ArenaVector<size_t> &shipped, ArenaVector<size_t> &bag) const;
+
+    void Remove(const ArenaVector<size_t> &shipped);
+
+    // Packages read so far by Candidates, All and Remove.
+    size_t ItemsScanned() const { return scanned; }
+};
@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <map>
+#include "weight_class_selector.h"
+#include "kp_kernel.h"
+
+ArenaVector<size_t> SelectByWeightClasses(const SelectionItems &items, int max_carriable_weight)
+{
+    struct bundle
+    {
+        size_t weight_class;
+        int count;
+        int weight;
+    };
+
+    std::map<int, ArenaVector<size_t>, std::less<int>, ArenaAllocator<std::pair<const int, ArenaVector<size_t>>>> classes;
+    for (size_t p = 0; p < items.size(); p++)
+    {
+        if (items[p].weight >= 0 && items[p].weight <= max_carriable_weight)
+        {
+            classes[items[p].weight].push_back(p);
+        }
+    }
+
+    ArenaVector<const ArenaVector<size_t> *> members;
+    ArenaVector<bundle> bundles;
+
+    for (auto &&weight_class : classes)
+    {
+        const int weight = weight_class.first;
+        int left = static_cast<int>(weight_class.second.size());
+
+        if (weight > 0)
+        {
+            left = std::min(left, max_carriable_weight / weight);
+        }
+
+        for (int count = 1; left > 0; count <<= 1)
+        {
+            int taken = std::min(count, left);
+            bundles.push_back(bundle{members.size(), taken, taken * weight});
+            left -= taken;
+        }
+        members.push_back(&weight_class.second);
+    }
+
+    const size_t words_per_bundle = (static_cast<size_t>(max_carriable_weight) >> 6) + 1;
+    ArenaVector<uint64_t> scores(max_carriable_weight + 1, 0);
+    ArenaVector<uint64_t> decisions(bundles.size() * words_per_bundle, 0);
+
+    for (size_t b = 0; b < bundles.size(); b++)
+    {
+        RelaxScores(scores.data(), decisions.data() + b * words_per_bundle, max_carriable_weight, bundles[b].weight, bundles[b].count);
+    }
+
+    ArenaVector<int> chosen(members.size(), 0);
+    int capacity = max_carriable_weight;
+
+    for (size_t b = bundles.size(); b-- > 0;)
+    {
+        if ((decisions[b * words_per_bundle + (capacity >> 6)] >> (capacity & 63)) & 1)
+        {
+            chosen[bundles[b].weight_class] += bundles[b].count;
+            capacity -= bundles[b].weight;
+        }
+    }
+
+    ArenaVector<size_t> positions;
+    for (size_t c = 0; c < members.size(); c++)
+    {
+        if (chosen[c] == 0)
+        {
+            continue;
+        }
+
+        ArenaVector<size_t> nearest = *members[c];
+        std::partial_sort(nearest.begin(), nearest.begin() + chosen[c], nearest.end(),
+                          [&items](size_t lhs, size_t rhs)
+                          {
+                              return items[lhs].distance < items[rhs].distance ||
+                                     (items[lhs].distance == items[rhs].distance && lhs < rhs);
+                          });
+        positions.insert(positions.end(), nearest.begin(), nearest.begin() + chosen[c]);
+    }
+
+    std::sort(positions.rbegin(), positions.rend());
+
+    ArenaVector<size_t> bag;
+    for (auto &&p : positions)
+    {
+        bag.push_back(items[p].idx);
+    }
+    return bag;
+}
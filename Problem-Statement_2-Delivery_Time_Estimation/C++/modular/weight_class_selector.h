@@ -0,0 +1,11 @@
+#pragma once
+
+#include "selection.h"
+
+// Bounded-knapsack engine for manifests with many packages of the same weight. Packages are grouped into weight
+// classes with multiplicities, each class is split into binary bundles (1, 2, 4, ..., rest packages) and the
+// bundles run through the packed-score kp kernel, so a class of m packages costs log2(m) sweeps instead of m.
+// The chosen number of packages per class is then filled with the nearest packages of that class
+// (lower index on equal distance). This tie-break differs from Delivery::kp, which would take the lowest
+// indices, so the engine is only used when asked for explicitly.
+ArenaVector<size_t> SelectByWeightClasses(const SelectionItems &items, int max_carriable_weight);
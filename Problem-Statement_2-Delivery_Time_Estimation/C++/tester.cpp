@@ -234,6 +234,33 @@ void package_time_computation_with_weight_tie()
     std::cout << "Test : package_time_computation PASSED" << '\n';
 }
 
+void package_time_computation_with_grouped_packages()
+{
+    std::vector<float> expected_delivery_time = {0.42f, 1.78f, 1.42f, 4.41f, 4.19f};
+    std::vector<Package> pkgs =
+        {
+            Package("pkg_id01", 50, 30),
+            Package("pkg_id02", 75, 125),
+            Package("pkg_id03", 175, 100),
+            Package("pkg_id04", 110, 60),
+            Package("pkg_id05", 155, 95)};
+    // pkg_id01 and pkg_id02 are one order, they leave first as the only pair that fits and pkg_id04 goes last.
+    pkgs[0].setGroupId("order01");
+    pkgs[1].setGroupId("order01");
+    const int no_of_vehicles = 2, max_speed = 70, max_carriable_weight = 200;
+    Delivery::Delivery_Time(pkgs, no_of_vehicles, max_speed, max_carriable_weight);
+
+    for (size_t i = 0; i < pkgs.size(); i++)
+    {
+        if (pkgs[i].getDeliveryTime() != expected_delivery_time[i])
+        {
+            std::cout << "Test : package_time_computation_with_grouped_packages FAILED" << '\n';
+            return;
+        }
+    }
+    std::cout << "Test : package_time_computation_with_grouped_packages PASSED" << '\n';
+}
+
 void workflow_integration_test()
 {
     std::stringstream oss, iss;
@@ -366,6 +393,83 @@ void workflow_integration_test_with_package_weight_greater_than_max_carriable_we
     }
 }
 
+void workflow_integration_test_with_grouped_packages()
+{
+    std::stringstream oss, iss;
+    // PKG1 carries its group without a volume, PKG2 after one, both read as the same order.
+    iss << "100 5\nPKG1 50 30 NA order01\nPKG2 75 125 NA 4 order01\nPKG3 175 100 NA\nPKG4 110 60 NA\nPKG5 155 95 NA \n2 70 200\n";
+    Delivery::ExecuteWorkflow(iss, oss);
+    std::string output = "";
+    std::array<std::pair<std::string, std::string>, 5> expected_errors =
+        {
+            std::make_pair("PKG1", "PKG1 0.00 750.00 0.42"),
+            std::make_pair("PKG2", "PKG2 0.00 1475.00 1.78"),
+            std::make_pair("PKG3", "PKG3 0.00 2350.00 1.42"),
+            std::make_pair("PKG4", "PKG4 0.00 1500.00 4.41"),
+            std::make_pair("PKG5", "PKG5 0.00 2125.00 4.19")};
+
+    size_t idx = 0;
+
+    std::cout << "Test : workflow_integration_test_with_grouped_packages : " << '\n';
+    bool testFailed = false;
+
+    while (std::getline(oss, output, '\n') && idx < expected_errors.size())
+    {
+        if (output.compare(expected_errors[idx].second) != 0)
+        {
+            std::cout << "\t Values for Package Id : " << expected_errors[idx].first << " does not Match Expected : " << expected_errors[idx].second << ", Actual : " << output << '\n';
+            testFailed = true;
+        }
+        idx++;
+    }
+    if (testFailed || idx != expected_errors.size())
+    {
+        std::cout << "\t Test workflow_integration_test_with_grouped_packages : FAILED" << '\n';
+    }
+    else
+    {
+        std::cout << "\t Test workflow_integration_test_with_grouped_packages : PASSED" << '\n';
+    }
+}
+
+void workflow_integration_test_with_short_package_line()
+{
+    std::stringstream oss, iss;
+    Delivery::SetUpDelivery("modular\\json_files\\offers.json", false, oss);
+    oss.str("");
+    // PKG2 has neither a distance nor an offer, it must not take OFR001 from PKG1.
+    iss << "100 2\nPKG1 100 100 OFR001\nPKG2 75\n1 70 200\n";
+    Delivery::ExecuteWorkflow(iss, oss);
+    std::string output = "";
+    std::array<std::pair<std::string, std::string>, 2> expected_errors =
+        {
+            std::make_pair("PKG1", "PKG1 160.00 1440.00 1.42"),
+            std::make_pair("PKG2", "PKG2 0.00 850.00 0.00")};
+
+    size_t idx = 0;
+
+    std::cout << "Test : workflow_integration_test_with_short_package_line : " << '\n';
+    bool testFailed = false;
+
+    while (std::getline(oss, output, '\n') && idx < expected_errors.size())
+    {
+        if (output.compare(expected_errors[idx].second) != 0)
+        {
+            std::cout << "\t Values for Package Id : " << expected_errors[idx].first << " does not Match Expected : " << expected_errors[idx].second << ", Actual : " << output << '\n';
+            testFailed = true;
+        }
+        idx++;
+    }
+    if (testFailed || idx != expected_errors.size())
+    {
+        std::cout << "\t Test workflow_integration_test_with_short_package_line : FAILED" << '\n';
+    }
+    else
+    {
+        std::cout << "\t Test workflow_integration_test_with_short_package_line : PASSED" << '\n';
+    }
+}
+
 int main()
 {
     malformed_json_offers();
@@ -378,7 +482,10 @@ int main()
     package_cost_computation_with_different_distance_multiplier();
     package_time_computation();
     package_time_computation_with_weight_tie();
+    package_time_computation_with_grouped_packages();
     workflow_integration_test();
     workflow_integration_test_with_weight_tie();
     workflow_integration_test_with_package_weight_greater_than_max_carriable_weight();
+    workflow_integration_test_with_grouped_packages();
+    workflow_integration_test_with_short_package_line();
 }
\ No newline at end of file